@@ -0,0 +1,150 @@
+/******************************************************************************
+* FILE: osmpExecutable_EventFd.c
+* DESCRIPTION:
+* OSMP program in which rank 0 waits in poll() on the descriptor from
+* OSMP_GetEventFd(): first for a message from rank 1, then for the
+* completion of an OSMP_IRecv and finally for a batch of inline messages sent
+* with OSMP_SendBatch. The descriptor must not be readable while nothing is
+* pending.
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define TIMEOUT_MS 10000
+#define BATCH 4
+
+/**
+ * Wartet mit poll(), bis das Eventfd lesbar ist, und setzt seinen Zähler zurück.
+ * @param fd         Das Eventfd.
+ * @param timeout_ms Höchste Wartezeit in Millisekunden.
+ * @return 1, wenn das Eventfd lesbar war, sonst 0.
+ */
+int wait_for_event(int fd, int timeout_ms) {
+    struct pollfd pfd = {fd, POLLIN, 0};
+    if(poll(&pfd, 1, timeout_ms) != 1) {
+        return 0;
+    }
+    uint64_t counter;
+    return read(fd, &counter, sizeof(counter)) == (ssize_t)sizeof(counter);
+}
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, tag, len, flag;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+    if (size != 2) {
+        printf("You have to start runner with 2 processes exactly.\n");
+        OSMP_Finalize();
+        return -1;
+    }
+
+    int errors = 0;
+    int value = -1;
+    if(rank == 0) {
+        int fd;
+        if(OSMP_GetEventFd(&fd) != OSMP_SUCCESS || wait_for_event(fd, 0)) {
+            errors++;
+        }
+        OSMP_Barrier();
+
+        // Rang 1 sendet erst nach der Barriere
+        int received = 0;
+        while(!received && wait_for_event(fd, TIMEOUT_MS)) {
+            if(OSMP_Iprobe(1, OSMP_ANY_TAG, &flag, &source, &tag, &len) == OSMP_SUCCESS && flag) {
+                rv = OSMP_Recv(&value, 1, OSMP_INT, &source, &len);
+                received = rv == OSMP_SUCCESS && value == 1;
+            }
+        }
+        if(!received) {
+            errors++;
+        }
+
+        OSMP_Request request;
+        if(OSMP_CreateRequest(&request) != OSMP_SUCCESS
+           || OSMP_IRecv(&value, 1, OSMP_INT, &source, &len, request) != OSMP_SUCCESS) {
+            errors++;
+        }
+        OSMP_Barrier();
+
+        // Lesbar sowohl durch die Nachricht als auch durch den Abschluss der Request
+        flag = OSMP_WAITING;
+        while(flag != OSMP_DONE && wait_for_event(fd, TIMEOUT_MS)) {
+            OSMP_Test(request, &flag);
+        }
+        if(flag != OSMP_DONE || value != 2 || OSMP_RemoveRequest(&request) != OSMP_SUCCESS) {
+            errors++;
+        }
+
+        // Ein Signal der abgeschlossenen Request kann noch ausstehen und wird vor dem Stapel verworfen
+        OSMP_Barrier();
+        wait_for_event(fd, 0);
+        OSMP_Barrier();
+        if(!wait_for_event(fd, TIMEOUT_MS)) {
+            errors++;
+        }
+        for(int i = 0; i < BATCH; i++) {
+            if(OSMP_Recv(&value, 1, OSMP_INT, &source, &len) != OSMP_SUCCESS || value != 3 + i) {
+                errors++;
+            }
+        }
+        printf("OSMP process %d was woken by its eventfd\n", rank);
+    } else {
+        OSMP_Barrier();
+        value = 1;
+        if(OSMP_Send(&value, 1, OSMP_INT, 0) != OSMP_SUCCESS) {
+            errors++;
+        }
+        OSMP_Barrier();
+        value = 2;
+        if(OSMP_Send(&value, 1, OSMP_INT, 0) != OSMP_SUCCESS) {
+            errors++;
+        }
+
+        // Vier Inline-Nachrichten in einem Aufruf
+        int values[BATCH];
+        OSMP_Msg msgs[BATCH];
+        for(int i = 0; i < BATCH; i++) {
+            values[i] = 3 + i;
+            msgs[i].buf = &values[i];
+            msgs[i].count = 1;
+            msgs[i].datatype = OSMP_INT;
+            msgs[i].tag = 0;
+        }
+        OSMP_Barrier();
+        OSMP_Barrier();
+        if(OSMP_SendBatch(msgs, BATCH, 0) != OSMP_SUCCESS) {
+            errors++;
+        }
+    }
+
+    if(errors != 0) {
+        printf("OSMP process %d: %d errors\n", rank, errors);
+        OSMP_Finalize();
+        return -1;
+    }
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+* FILE: osmpExecutable_Exchange.c
+* DESCRIPTION:
+* OSMP program in which two ranks both send a 128 KiB message to each other
+* before they receive. OSMP_Send must buffer messages up to the maximum
+* payload instead of waiting for the receiver, otherwise both ranks block.
+* Longer messages are documented to wait for the receiver, so the exchange
+* is shortened to the maximum payload when osmp_run -P sets a smaller one.
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define EXCHANGE_LENGTH (128 * 1024)
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, len;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+    if (size != 2) {
+        printf("You have to start runner with 2 processes exactly.\n");
+        OSMP_Finalize();
+        return -1;
+    }
+
+    int length = EXCHANGE_LENGTH < get_OSMP_MAX_PAYLOAD_LENGTH() ? EXCHANGE_LENGTH : get_OSMP_MAX_PAYLOAD_LENGTH();
+    unsigned char *send_buf = malloc((size_t) length);
+    unsigned char *recv_buf = malloc((size_t) length);
+    if(send_buf == NULL || recv_buf == NULL){
+        OSMP_Finalize();
+        printf("malloc failed for rank %d\n", rank);
+        return -1;
+    }
+
+    int errors = 0;
+    // Muster aus Rang und Position, damit der Empfänger den Inhalt prüfen kann
+    for(int j = 0; j < length; j++) {
+        send_buf[j] = (unsigned char) (rank + j);
+    }
+    if(OSMP_Send(send_buf, length, OSMP_BYTE, 1 - rank) != OSMP_SUCCESS) {
+        errors++;
+    }
+    // Der eigene Puffer darf nach OSMP_Send() überschrieben werden
+    for(int j = 0; j < length; j++) {
+        send_buf[j] = 0;
+    }
+    rv = OSMP_Recv(recv_buf, length, OSMP_BYTE, &source, &len);
+    if(rv != OSMP_SUCCESS || source != 1 - rank || len != length) {
+        errors++;
+    } else {
+        for(int j = 0; j < len; j++) {
+            if(recv_buf[j] != (unsigned char) (source + j)) {
+                errors++;
+                break;
+            }
+        }
+    }
+    printf("OSMP process %d exchanged %d bytes with rank %d\n", rank, length, 1 - rank);
+    free(send_buf);
+    free(recv_buf);
+
+    if(errors != 0) {
+        printf("OSMP process %d: %d errors\n", rank, errors);
+        OSMP_Finalize();
+        return -1;
+    }
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+/******************************************************************************
+* FILE: osmpExecutable_FlowControl.c
+* DESCRIPTION:
+* OSMP program in which rank 0 floods rank 1 with more OSMP_ISend calls than
+* there are message slots, while rank 1 only starts receiving after ranks 2
+* and 3 have finished a ping-pong. The ping-pong must not starve on slots.
+* Afterwards rank 1 floods rank 0 with messages larger than 256 bytes while
+* rank 0 first waits for a single message of rank 2, which must not starve on
+* heap blocks of the same size class.
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define FLOOD (OSMP_MAX_SLOTS + 64)
+#define ROUNDS 100
+#define LARGE_FLOOD 70
+#define LARGE 1000
+#define LARGE_SENT 40
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, len;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+    if (size != 4) {
+        printf("You have to start runner with 4 processes exactly.\n");
+        OSMP_Finalize();
+        return -1;
+    }
+
+    int errors = 0;
+    int *values = NULL;
+    OSMP_Request *requests = NULL;
+    if(rank == 0) {
+        // Jede Sendung belegt einen Slot, solange das Postfach von Rang 1 voll ist
+        values = malloc(FLOOD * sizeof(int));
+        requests = malloc(FLOOD * sizeof(OSMP_Request));
+        if(values == NULL || requests == NULL) {
+            printf("malloc failed for rank %d\n", rank);
+            return -1;
+        }
+        for(int i = 0; i < FLOOD; i++) {
+            values[i] = i;
+            if(OSMP_CreateRequest(&requests[i]) != OSMP_SUCCESS
+               || OSMP_ISend(&values[i], 1, OSMP_INT, 1, requests[i]) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+    } else if(rank >= 2) {
+        int peer = rank == 2 ? 3 : 2;
+        for(int i = 0; i < ROUNDS; i++) {
+            int value = i, received = -1;
+            if(rank == 2) {
+                rv = OSMP_Send(&value, 1, OSMP_INT, peer);
+                rv |= OSMP_Recv(&received, 1, OSMP_INT, &source, &len);
+            } else {
+                rv = OSMP_Recv(&received, 1, OSMP_INT, &source, &len);
+                rv |= OSMP_Send(&received, 1, OSMP_INT, peer);
+            }
+            if(rv != OSMP_SUCCESS || received != i || source != peer) {
+                errors++;
+            }
+        }
+        printf("OSMP process %d finished %d ping-pong rounds\n", rank, ROUNDS);
+    }
+
+    // Rang 1 beginnt erst zu lesen, wenn das Ping-Pong trotz der Flut fertig ist
+    OSMP_Barrier();
+
+    if(rank == 0) {
+        for(int i = 0; i < FLOOD; i++) {
+            if(OSMP_Wait(requests[i]) != OSMP_SUCCESS || OSMP_RemoveRequest(&requests[i]) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+        free(requests);
+        free(values);
+    } else if(rank == 1) {
+        // Die Threads von OSMP_ISend() legen ihre Nachrichten in beliebiger Reihenfolge ab
+        char *seen = calloc(FLOOD, sizeof(char));
+        if(seen == NULL) {
+            printf("calloc failed for rank %d\n", rank);
+            return -1;
+        }
+        for(int i = 0; i < FLOOD; i++) {
+            int value = -1;
+            rv = OSMP_Recv(&value, 1, OSMP_INT, &source, &len);
+            if(rv != OSMP_SUCCESS || source != 0 || value < 0 || value >= FLOOD || seen[value]) {
+                errors++;
+            } else {
+                seen[value] = 1;
+            }
+        }
+        free(seen);
+        printf("OSMP process %d received %d flooded messages\n", rank, FLOOD);
+    }
+
+    // Zweite Flut mit Nachrichten aus einer Größenklasse mit begrenzter Blockanzahl
+    OSMP_Barrier();
+    if(rank == 1) {
+        char *buffers = malloc(LARGE_FLOOD * LARGE);
+        requests = malloc(LARGE_FLOOD * sizeof(OSMP_Request));
+        if(buffers == NULL || requests == NULL) {
+            printf("malloc failed for rank %d\n", rank);
+            return -1;
+        }
+        for(int i = 0; i < LARGE_FLOOD; i++) {
+            memset(buffers + i * LARGE, i, LARGE);
+            if(OSMP_CreateRequest(&requests[i]) != OSMP_SUCCESS
+               || OSMP_ISend(buffers + i * LARGE, LARGE, OSMP_BYTE, 0, requests[i]) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+        // Rang 2 darf erst senden, wenn die Flut einen Großteil der Heap-Blöcke belegt. In Teilstücken gesendete
+        // Nachrichten warten dagegen auf den Empfänger und können vorher nicht abgeschlossen sein.
+        int sent = LARGE <= get_OSMP_MAX_PAYLOAD_LENGTH() ? 0 : LARGE_SENT;
+        while(sent < LARGE_SENT) {
+            sent = 0;
+            for(int i = 0; i < LARGE_FLOOD; i++) {
+                int flag = 0;
+                OSMP_Test(requests[i], &flag);
+                sent += flag;
+            }
+        }
+        int go = 1;
+        if(OSMP_Send(&go, 1, OSMP_INT, 2) != OSMP_SUCCESS) {
+            errors++;
+        }
+        if(OSMP_Waitall(LARGE_FLOOD, requests) != OSMP_SUCCESS) {
+            errors++;
+        }
+        for(int i = 0; i < LARGE_FLOOD; i++) {
+            if(OSMP_RemoveRequest(&requests[i]) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+        free(requests);
+        free(buffers);
+    } else if(rank == 2) {
+        char buffer[LARGE];
+        int go = 0;
+        memset(buffer, 0xff, LARGE);
+        if(OSMP_Recv(&go, 1, OSMP_INT, &source, &len) != OSMP_SUCCESS
+           || OSMP_Send(buffer, LARGE, OSMP_BYTE, 0) != OSMP_SUCCESS) {
+            errors++;
+        }
+    } else if(rank == 0) {
+        char buffer[LARGE];
+        int tag;
+        // OSMP_Probe() nimmt die Flut von Rang 1 aus dem Postfach, ohne einen Empfangspuffer bereitzustellen; die
+        // Nachricht von Rang 2 muss also wie die Flut einen Heap-Block belegen
+        rv = OSMP_Probe(2, OSMP_ANY_TAG, &source, &tag, &len);
+        rv |= OSMP_RecvFrom(buffer, LARGE, OSMP_BYTE, 2, OSMP_ANY_TAG, &source, &tag, &len);
+        if(rv != OSMP_SUCCESS || source != 2 || len != LARGE || (unsigned char) buffer[LARGE - 1] != 0xff) {
+            errors++;
+        }
+        char *seen = calloc(LARGE_FLOOD, sizeof(char));
+        if(seen == NULL) {
+            printf("calloc failed for rank %d\n", rank);
+            return -1;
+        }
+        for(int i = 0; i < LARGE_FLOOD; i++) {
+            rv = OSMP_RecvFrom(buffer, LARGE, OSMP_BYTE, 1, OSMP_ANY_TAG, &source, &tag, &len);
+            int value = (unsigned char) buffer[0];
+            if(rv != OSMP_SUCCESS || len != LARGE || value >= LARGE_FLOOD || seen[value]
+               || (unsigned char) buffer[LARGE - 1] != value) {
+                errors++;
+            } else {
+                seen[value] = 1;
+            }
+        }
+        free(seen);
+        printf("OSMP process %d received %d large flooded messages\n", rank, LARGE_FLOOD);
+    }
+
+    if(errors != 0) {
+        printf("OSMP process %d: %d errors\n", rank, errors);
+        OSMP_Finalize();
+        return -1;
+    }
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
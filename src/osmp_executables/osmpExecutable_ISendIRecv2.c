@@ -66,9 +66,9 @@ int main(int argc, char *argv[]) {
 
 
 
+    rv = OSMP_Waitall(size-1, myrequest);
     for(int i=0; i<size-1; i++) {
-        rv = OSMP_Wait( myrequest[i] );
-        rv = OSMP_RemoveRequest(myrequest[i]);
+        rv = OSMP_RemoveRequest(&(myrequest[i]));
     }
 
     rv = OSMP_Finalize();
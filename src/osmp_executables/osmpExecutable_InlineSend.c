@@ -0,0 +1,125 @@
+/******************************************************************************
+* FILE: osmpExecutable_InlineSend.c
+* DESCRIPTION:
+* OSMP program in which rank 1 sends more small messages to rank 0 than there
+* are message slots, followed by a message with another tag that rank 0
+* receives first. Small messages travel inside the postbox entry, so this must
+* not run out of slots. Rank 2 sends a batch of messages with lengths around
+* the inline limit, which rank 0 checks byte by byte.
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define FLOOD (2 * OSMP_MAX_SLOTS)
+#define SIZES 64
+#define FLOOD_TAG 1
+#define LAST_TAG 2
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, tag, len;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+    if (size != 3) {
+        printf("You have to start runner with 3 processes exactly.\n");
+        OSMP_Finalize();
+        return -1;
+    }
+
+    int errors = 0;
+    char buffer[SIZES];
+    if(rank == 1) {
+        for(int i = 0; i < FLOOD; i++) {
+            if(OSMP_SendTag(&i, 1, OSMP_INT, 0, FLOOD_TAG) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+        int last = FLOOD;
+        if(OSMP_SendTag(&last, 1, OSMP_INT, 0, LAST_TAG) != OSMP_SUCCESS) {
+            errors++;
+        }
+    } else if(rank == 2) {
+        // Nachricht i hat i + 1 Bytes, liegt also teils im Postfach-Eintrag und teils in einem Nachrichtenslot
+        char *payloads = malloc(SIZES * SIZES);
+        OSMP_Msg *msgs = malloc(SIZES * sizeof(OSMP_Msg));
+        if(payloads == NULL || msgs == NULL) {
+            printf("malloc failed for rank %d\n", rank);
+            return -1;
+        }
+        for(int i = 0; i < SIZES; i++) {
+            for(int j = 0; j <= i; j++) {
+                payloads[i * SIZES + j] = (char)(i + j);
+            }
+            msgs[i].buf = &payloads[i * SIZES];
+            msgs[i].count = i + 1;
+            msgs[i].datatype = OSMP_BYTE;
+            msgs[i].tag = i;
+        }
+        if(OSMP_SendBatch(msgs, SIZES, 0) != OSMP_SUCCESS) {
+            errors++;
+        }
+        free(msgs);
+        free(payloads);
+    } else {
+        // Alle kleinen Nachrichten von Rang 1 müssen zwischengespeichert werden, bevor die letzte empfangen wird
+        int value = -1;
+        rv = OSMP_RecvFrom(&value, 1, OSMP_INT, 1, LAST_TAG, &source, &tag, &len);
+        if(rv != OSMP_SUCCESS || value != FLOOD || len != (int)sizeof(int)) {
+            errors++;
+        }
+        for(int i = 0; i < FLOOD; i++) {
+            rv = OSMP_RecvFrom(&value, 1, OSMP_INT, 1, OSMP_ANY_TAG, &source, &tag, &len);
+            if(rv != OSMP_SUCCESS || value != i || tag != FLOOD_TAG) {
+                errors++;
+            }
+        }
+        printf("OSMP process %d received %d small messages from rank 1\n", rank, FLOOD);
+
+        for(int i = 0; i < SIZES; i++) {
+            int actual_tag;
+            rv = OSMP_Probe(2, OSMP_ANY_TAG, &source, &actual_tag, &len);
+            if(rv != OSMP_SUCCESS || actual_tag != i || len != i + 1) {
+                errors++;
+            }
+            rv = OSMP_RecvFrom(buffer, SIZES, OSMP_BYTE, 2, OSMP_ANY_TAG, &source, &tag, &len);
+            if(rv != OSMP_SUCCESS || tag != i || len != i + 1) {
+                errors++;
+                continue;
+            }
+            for(int j = 0; j <= i; j++) {
+                if(buffer[j] != (char)(i + j)) {
+                    errors++;
+                    break;
+                }
+            }
+        }
+        printf("OSMP process %d received %d messages of growing length from rank 2\n", rank, SIZES);
+    }
+
+    if(errors != 0) {
+        printf("OSMP process %d: %d errors\n", rank, errors);
+        OSMP_Finalize();
+        return -1;
+    }
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
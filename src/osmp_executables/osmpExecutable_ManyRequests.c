@@ -0,0 +1,108 @@
+/******************************************************************************
+* FILE: osmpExecutable_ManyRequests.c
+* DESCRIPTION:
+* OSMP program in which two ranks each post REQUESTS non-blocking receives
+* and REQUESTS non-blocking sends to each other before waiting for any of
+* them. Sends to one receiver and receives are carried out in the order they
+* were posted, so every receive buffer must hold its own index. The first
+* send finds an empty postbox and must complete before OSMP_ISend returns.
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define REQUESTS 10000
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+    if (size != 2) {
+        printf("You have to start runner with 2 processes exactly.\n");
+        OSMP_Finalize();
+        return -1;
+    }
+
+    int errors = 0;
+    int peer = 1 - rank;
+    int *values = malloc(REQUESTS * sizeof(int));
+    int *received = malloc(REQUESTS * sizeof(int));
+    int *sources = malloc(REQUESTS * sizeof(int));
+    int *lens = malloc(REQUESTS * sizeof(int));
+    OSMP_Request *receives = malloc(REQUESTS * sizeof(OSMP_Request));
+    OSMP_Request *sends = malloc(REQUESTS * sizeof(OSMP_Request));
+    if(values == NULL || received == NULL || sources == NULL || lens == NULL || receives == NULL || sends == NULL) {
+        printf("malloc failed for rank %d\n", rank);
+        return -1;
+    }
+
+    for(int i = 0; i < REQUESTS; i++) {
+        received[i] = -1;
+        if(OSMP_CreateRequest(&receives[i]) != OSMP_SUCCESS
+           || OSMP_IRecv(&received[i], 1, OSMP_INT, &sources[i], &lens[i], receives[i]) != OSMP_SUCCESS) {
+            errors++;
+        }
+    }
+    // Beide Ränge sind danach erreichbar, und die Postfächer sind leer
+    OSMP_Barrier();
+    for(int i = 0; i < REQUESTS; i++) {
+        values[i] = i;
+        if(OSMP_CreateRequest(&sends[i]) != OSMP_SUCCESS
+           || OSMP_ISend(&values[i], 1, OSMP_INT, peer, sends[i]) != OSMP_SUCCESS) {
+            errors++;
+        }
+        if(i == 0) {
+            int flag;
+            if(OSMP_Test(sends[0], &flag) != OSMP_SUCCESS || flag != OSMP_DONE) {
+                printf("OSMP process %d: first send was not completed eagerly\n", rank);
+                errors++;
+            }
+        }
+    }
+
+    for(int i = 0; i < REQUESTS; i++) {
+        if(OSMP_Wait(receives[i]) != OSMP_SUCCESS || OSMP_Wait(sends[i]) != OSMP_SUCCESS) {
+            errors++;
+        }
+        if(received[i] != i || sources[i] != peer || lens[i] != (int)sizeof(int)) {
+            errors++;
+        }
+        OSMP_RemoveRequest(&receives[i]);
+        OSMP_RemoveRequest(&sends[i]);
+    }
+    printf("OSMP process %d completed %d receives and %d sends\n", rank, REQUESTS, REQUESTS);
+
+    free(sends);
+    free(receives);
+    free(lens);
+    free(sources);
+    free(received);
+    free(values);
+
+    if(errors != 0) {
+        printf("OSMP process %d: %d errors\n", rank, errors);
+        OSMP_Finalize();
+        return -1;
+    }
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
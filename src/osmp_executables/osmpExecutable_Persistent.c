@@ -0,0 +1,105 @@
+/******************************************************************************
+* FILE: osmpExecutable_Persistent.c
+* DESCRIPTION:
+* OSMP program with persistent requests: rank 0 binds a send and a receive
+* once and restarts both in every round with OSMP_Startall(), rank 1 echoes
+* each value incremented by one using its own persistent requests.
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define ROUNDS 1000
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+    if (size != 2) {
+        printf("You have to start runner with 2 processes exactly.\n");
+        OSMP_Finalize();
+        return -1;
+    }
+
+    int errors = 0;
+    int peer = 1 - rank;
+    int outgoing[2] = {0, 0};
+    int incoming[2] = {-1, -1};
+    int source = -1, len = -1;
+    OSMP_Request requests[2];
+    if(OSMP_CreateRequest(&requests[0]) != OSMP_SUCCESS || OSMP_CreateRequest(&requests[1]) != OSMP_SUCCESS
+       || OSMP_Send_init(outgoing, 2, OSMP_INT, peer, requests[0]) != OSMP_SUCCESS
+       || OSMP_Recv_init(incoming, 2, OSMP_INT, &source, &len, requests[1]) != OSMP_SUCCESS) {
+        printf("OSMP process %d couldn't bind persistent requests\n", rank);
+        return -1;
+    }
+
+    // Gebundene Requests dürfen nicht mehr mit OSMP_ISend() verwendet werden, ungebundene nicht gestartet werden
+    OSMP_Request unbound;
+    if(OSMP_ISend(outgoing, 2, OSMP_INT, peer, requests[0]) != OSMP_FAILURE
+       || OSMP_CreateRequest(&unbound) != OSMP_SUCCESS || OSMP_Start(unbound) != OSMP_FAILURE
+       || OSMP_RemoveRequest(&unbound) != OSMP_SUCCESS) {
+        errors++;
+    }
+
+    for(int i = 0; i < ROUNDS; i++) {
+        if(rank == 0) {
+            outgoing[0] = i;
+            outgoing[1] = -i;
+            if(OSMP_Startall(2, requests) != OSMP_SUCCESS) {
+                errors++;
+            }
+            OSMP_Wait(requests[0]);
+            OSMP_Wait(requests[1]);
+            if(incoming[0] != i + 1 || incoming[1] != -i - 1) {
+                errors++;
+            }
+        } else {
+            if(OSMP_Start(requests[1]) != OSMP_SUCCESS) {
+                errors++;
+            }
+            OSMP_Wait(requests[1]);
+            outgoing[0] = incoming[0] + 1;
+            outgoing[1] = incoming[1] - 1;
+            if(OSMP_Start(requests[0]) != OSMP_SUCCESS) {
+                errors++;
+            }
+            OSMP_Wait(requests[0]);
+        }
+        if(source != peer || len != 2 * (int)sizeof(int)) {
+            errors++;
+        }
+    }
+    printf("OSMP process %d finished %d rounds with persistent requests\n", rank, ROUNDS);
+
+    if(OSMP_RemoveRequest(&requests[0]) != OSMP_SUCCESS || OSMP_RemoveRequest(&requests[1]) != OSMP_SUCCESS) {
+        errors++;
+    }
+
+    if(errors != 0) {
+        printf("OSMP process %d: %d errors\n", rank, errors);
+        OSMP_Finalize();
+        return -1;
+    }
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/******************************************************************************
+* FILE: osmpExecutable_PostedRecv.c
+* DESCRIPTION:
+* OSMP program in which rank 0 posts OSMP_IRecv calls before rank 1 sends, so
+* rank 1 can write straight into the posted buffers. Messages range from just
+* above the inline limit to beyond the rendezvous threshold. A message that is
+* already queued when the receive is posted must still be received first.
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define ROUNDS 200
+#define SMALL 1024
+#define LARGE (256 * 1024)
+// Über der Grenze für Inline-Nachrichten, aber klein genug für einen Nachrichtenslot, damit das Senden nie blockiert
+#define QUEUED 64
+
+/**
+ * Füllt einen Puffer mit einem Muster, das von der Nummer der Nachricht abhängt.
+ * @param buf   Der Puffer.
+ * @param len   Länge in Bytes.
+ * @param round Nummer der Nachricht.
+ */
+void fill_pattern(char *buf, int len, int round) {
+    for(int i = 0; i < len; i++) {
+        buf[i] = (char)(i * 7 + round);
+    }
+}
+
+/**
+ * Prüft das Muster aus fill_pattern().
+ * @param buf   Der Puffer.
+ * @param len   Länge in Bytes.
+ * @param round Nummer der Nachricht.
+ * @return 1, wenn der Puffer das Muster enthält, sonst 0.
+ */
+int check_pattern(const char *buf, int len, int round) {
+    for(int i = 0; i < len; i++) {
+        if(buf[i] != (char)(i * 7 + round)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, len;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+    if (size != 2) {
+        printf("You have to start runner with 2 processes exactly.\n");
+        OSMP_Finalize();
+        return -1;
+    }
+
+    int errors = 0;
+    char *buffer = malloc(LARGE);
+    char *second = malloc(QUEUED);
+    OSMP_Request request, other;
+    if(buffer == NULL || second == NULL
+       || OSMP_CreateRequest(&request) != OSMP_SUCCESS || OSMP_CreateRequest(&other) != OSMP_SUCCESS) {
+        printf("OSMP process %d couldn't allocate buffers\n", rank);
+        return -1;
+    }
+
+    // Ping-Pong: Rang 0 stellt seinen Puffer bereit, bevor Rang 1 sendet
+    for(int i = 0; i < ROUNDS; i++) {
+        int length = i % 10 == 9 ? LARGE : SMALL - i;
+        if(rank == 0) {
+            rv = OSMP_IRecv(buffer, LARGE, OSMP_BYTE, &source, &len, request);
+            rv |= OSMP_Send(&i, 1, OSMP_INT, 1);
+            rv |= OSMP_Wait(request);
+            if(rv != OSMP_SUCCESS || source != 1 || len != length || !check_pattern(buffer, length, i)) {
+                errors++;
+            }
+        } else {
+            int round = -1;
+            rv = OSMP_Recv(&round, 1, OSMP_INT, &source, &len);
+            fill_pattern(buffer, length, round);
+            rv |= OSMP_Send(buffer, length, OSMP_BYTE, 0);
+            if(rv != OSMP_SUCCESS || round != i) {
+                errors++;
+            }
+        }
+    }
+    printf("OSMP process %d finished %d rounds with posted receives\n", rank, ROUNDS);
+
+    // Eine bereits eingetroffene Nachricht darf von einer direkt geschriebenen nicht überholt werden
+    if(rank == 0) {
+        OSMP_Barrier();
+        rv = OSMP_IRecv(buffer, QUEUED, OSMP_BYTE, &source, &len, request);
+        rv |= OSMP_IRecv(second, QUEUED, OSMP_BYTE, &source, &len, other);
+        OSMP_Barrier();
+        rv |= OSMP_Wait(request);
+        rv |= OSMP_Wait(other);
+        if(rv != OSMP_SUCCESS || !check_pattern(buffer, QUEUED, 1) || !check_pattern(second, QUEUED, 2)) {
+            errors++;
+        }
+    } else {
+        fill_pattern(buffer, QUEUED, 1);
+        rv = OSMP_Send(buffer, QUEUED, OSMP_BYTE, 0);
+        OSMP_Barrier();
+        OSMP_Barrier();
+        fill_pattern(buffer, QUEUED, 2);
+        rv |= OSMP_Send(buffer, QUEUED, OSMP_BYTE, 0);
+        if(rv != OSMP_SUCCESS) {
+            errors++;
+        }
+    }
+
+    if(OSMP_RemoveRequest(&request) != OSMP_SUCCESS || OSMP_RemoveRequest(&other) != OSMP_SUCCESS) {
+        errors++;
+    }
+    free(second);
+    free(buffer);
+
+    if(errors != 0) {
+        printf("OSMP process %d: %d errors\n", rank, errors);
+        OSMP_Finalize();
+        return -1;
+    }
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+/******************************************************************************
+* FILE: osmpExecutable_Probe.c
+* DESCRIPTION:
+* OSMP program in which rank 0 sizes its receive buffers with OSMP_Probe and
+* OSMP_Iprobe before receiving messages of different lengths
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+
+#include "../osmp_library/OSMP.h"
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, tag, len;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+
+    if(rank != 0) {
+        // Jeder Rang sendet eine Nachricht, deren Länge vom Rang abhängt
+        int length = rank * 100;
+        unsigned char *buf = malloc((size_t) length);
+        if(buf == NULL){
+            OSMP_Finalize();
+            printf("malloc failed for rank %d\n", rank);
+            return -1;
+        }
+        for(int j = 0; j < length; j++) {
+            buf[j] = (unsigned char) (rank + j);
+        }
+        rv = OSMP_SendTag(buf, length, OSMP_BYTE, 0, rank);
+        free(buf);
+        if(rv == OSMP_FAILURE){
+            OSMP_Finalize();
+            printf("OSMP_SendTag returned error for rank %d\n", rank);
+            return -1;
+        }
+    } else {
+        int errors = 0;
+        int *received = calloc((size_t) size, sizeof(int));
+        for(int i = 1; i < size; i++) {
+            int flag = 0;
+            if(i % 2 == 0) {
+                // Blockierend auf den höchsten Sender warten, dessen Nachricht noch fehlt
+                int wanted = size - 1;
+                while(received[wanted]) {
+                    wanted--;
+                }
+                rv = OSMP_Probe(wanted, OSMP_ANY_TAG, &source, &tag, &len);
+            } else {
+                // Nicht-blockierend auf eine beliebige Nachricht warten
+                while(!flag) {
+                    rv = OSMP_Iprobe(OSMP_ANY_SOURCE, OSMP_ANY_TAG, &flag, &source, &tag, &len);
+                    if(rv == OSMP_FAILURE) {
+                        break;
+                    }
+                    sched_yield();
+                }
+            }
+            if(rv == OSMP_FAILURE || len != source * 100 || tag != source) {
+                errors++;
+                continue;
+            }
+            received[source] = 1;
+
+            // Puffer mit genau der gemeldeten Größe anlegen; die Nachricht muss noch vorhanden sein
+            unsigned char *buf = malloc((size_t) len);
+            int received_source, received_tag, received_len;
+            rv = OSMP_RecvFrom(buf, len, OSMP_BYTE, source, tag, &received_source, &received_tag, &received_len);
+            if(rv == OSMP_FAILURE || received_source != source || received_len != len) {
+                errors++;
+            } else {
+                for(int j = 0; j < len; j++) {
+                    if(buf[j] != (unsigned char) (source + j)) {
+                        errors++;
+                        break;
+                    }
+                }
+            }
+            free(buf);
+        }
+        free(received);
+        printf("OSMP process %d probed %d messages, %d mismatched\n", rank, size - 1, errors);
+        if(errors != 0) {
+            OSMP_Finalize();
+            return -1;
+        }
+    }
+
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+* FILE: osmpExecutable_RecvBorrow.c
+* DESCRIPTION:
+* OSMP program that reads its messages in place with OSMP_RecvBorrow/OSMP_RecvRelease
+******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+
+#include "../osmp_library/OSMP.h"
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, len;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+
+    if(rank != 0) {
+        char bufin[32];
+        snprintf(bufin, sizeof(bufin), "Hello from %d", rank);
+        rv = OSMP_Send(bufin, (int) strlen(bufin) + 1, OSMP_BYTE, 0);
+        if(rv == OSMP_FAILURE){
+            OSMP_Finalize();
+            printf("OSMP_Send returned error for rank %d\n", rank);
+            return -1;
+        }
+    } else {
+        for(int i = 1; i < size; i++) {
+            char *message;
+            rv = OSMP_RecvBorrow((void **) &message, &len, &source);
+            if(rv == OSMP_FAILURE){
+                OSMP_Finalize();
+                printf("OSMP_RecvBorrow returned error for rank %d\n", rank);
+                return -1;
+            }
+            // Nachricht direkt im Shared Memory auswerten
+            printf("OSMP process %d borrowed \"%s\" (%d bytes) from %d\n", rank, message, len, source);
+            rv = OSMP_RecvRelease(message);
+            if(rv == OSMP_FAILURE){
+                OSMP_Finalize();
+                printf("OSMP_RecvRelease returned error for rank %d\n", rank);
+                return -1;
+            }
+        }
+    }
+
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+* FILE: osmpExecutable_RecvFrom.c
+* DESCRIPTION:
+* OSMP program in which every rank sends tagged messages to rank 0, which
+* receives them by source and tag in a different order than they arrived
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define TAGS 3
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, tag, len;
+    int buf[2];
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+
+    if(rank != 0) {
+        // Inhalt: eigener Rang und Tag, damit der Empfänger die Zuordnung prüfen kann
+        for(int t = 0; t < TAGS; t++) {
+            buf[0] = rank;
+            buf[1] = t;
+            rv = OSMP_SendTag(buf, 2, OSMP_INT, 0, t);
+            if(rv == OSMP_FAILURE){
+                OSMP_Finalize();
+                printf("OSMP_SendTag returned error for rank %d\n", rank);
+                return -1;
+            }
+        }
+        // Diese Nachricht darf erst am Ende über OSMP_ANY_SOURCE empfangen werden
+        buf[0] = rank;
+        buf[1] = TAGS;
+        OSMP_Send(buf, 2, OSMP_INT, 0);
+    } else {
+        int errors = 0;
+        // Sender absteigend und Tags absteigend abholen, also entgegen der Ankunftsreihenfolge
+        for(int s = size - 1; s > 0; s--) {
+            for(int t = TAGS - 1; t > 0; t--) {
+                rv = OSMP_RecvFrom(buf, 2, OSMP_INT, s, t, &source, &tag, &len);
+                if(rv == OSMP_FAILURE || source != s || tag != t || buf[0] != s || buf[1] != t) {
+                    errors++;
+                }
+            }
+        }
+        // Tag 0 von beliebigen Sendern: Das sind die Nachrichten mit Tag 0 und die abschließenden Nachrichten
+        for(int i = 0; i < 2 * (size - 1); i++) {
+            rv = OSMP_RecvFrom(buf, 2, OSMP_INT, OSMP_ANY_SOURCE, 0, &source, &tag, &len);
+            if(rv == OSMP_FAILURE || tag != 0 || buf[0] != source || (buf[1] != 0 && buf[1] != TAGS)) {
+                errors++;
+            }
+        }
+        printf("OSMP process %d received %d messages, %d mismatched\n", rank, (TAGS + 1) * (size - 1), errors);
+        if(errors != 0) {
+            OSMP_Finalize();
+            return -1;
+        }
+    }
+
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
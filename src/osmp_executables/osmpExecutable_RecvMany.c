@@ -0,0 +1,103 @@
+/******************************************************************************
+* FILE: osmpExecutable_RecvMany.c
+* DESCRIPTION:
+* OSMP program in which rank 0 receives the messages of all other ranks in
+* batches with OSMP_RecvMany, while rank 1 leaves messages unread for
+* OSMP_Finalize to drain
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define MESSAGES 10
+#define MAXN 8
+#define LEFTOVERS 3
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+
+    if(rank != 0) {
+        int buf[2];
+        buf[0] = rank;
+        for(int i = 0; i < MESSAGES; i++) {
+            buf[1] = i;
+            rv = OSMP_Send(buf, 2, OSMP_INT, 0);
+            if(rv == OSMP_FAILURE){
+                OSMP_Finalize();
+                printf("OSMP_Send returned error for rank %d\n", rank);
+                return -1;
+            }
+        }
+        // Rang 1 liest diese Nachrichten nie; OSMP_Finalize() muss sie verwerfen
+        if(rank != 1) {
+            for(int i = 0; i < LEFTOVERS; i++) {
+                OSMP_Send(buf, 2, OSMP_INT, 1);
+            }
+        }
+    } else {
+        int errors = 0, received = 0, calls = 0;
+        int storage[MAXN][2];
+        void *bufs[MAXN];
+        int sources[MAXN], lens[MAXN];
+        int *next = calloc((size_t)size, sizeof(int));
+        if(next == NULL) {
+            printf("calloc failed for rank %d\n", rank);
+            return -1;
+        }
+        for(int i = 0; i < MAXN; i++) {
+            bufs[i] = storage[i];
+        }
+
+        while(received < MESSAGES * (size - 1)) {
+            int got;
+            rv = OSMP_RecvMany(bufs, 2, OSMP_INT, MAXN, &got, sources, lens);
+            if(rv == OSMP_FAILURE || got < 1 || got > MAXN) {
+                errors++;
+                break;
+            }
+            calls++;
+            // Die Nachrichten eines Senders müssen in Sendereihenfolge ankommen
+            for(int i = 0; i < got; i++) {
+                int s = sources[i];
+                if(lens[i] != 2 * (int)sizeof(int) || storage[i][0] != s || storage[i][1] != next[s]) {
+                    errors++;
+                } else {
+                    next[s]++;
+                }
+            }
+            received += got;
+        }
+        free(next);
+        printf("OSMP process %d received %d messages in %d calls, %d mismatched\n", rank, received, calls, errors);
+        if(errors != 0) {
+            OSMP_Finalize();
+            return -1;
+        }
+    }
+
+    // Sicherstellen, dass alle übrig gebliebenen Nachrichten vor OSMP_Finalize() eingetroffen sind
+    OSMP_Barrier();
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
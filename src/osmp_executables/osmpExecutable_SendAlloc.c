@@ -0,0 +1,95 @@
+/******************************************************************************
+* FILE: osmpExecutable_SendAlloc.c
+* DESCRIPTION:
+* OSMP program that builds its messages in place with OSMP_SendAlloc/OSMP_SendCommit
+* and checks that OSMP_SendCommit only accepts blocks reserved for sending and
+* OSMP_RecvRelease only blocks lent by OSMP_RecvBorrow
+******************************************************************************/
+#include <stdio.h>
+
+#include "../osmp_library/OSMP.h"
+
+// Größer als eine Inline-Nachricht, damit der Empfänger den Block im Shared Memory leiht
+#define BORROW_INTS 16
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, len;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+
+    // Nachricht direkt im Nachrichtenslot des Nachbarn aufbauen
+    int *payload;
+    int dest = (rank + 1) % size;
+    rv = OSMP_SendAlloc(dest, 2 * (int)sizeof(int), (void **) &payload);
+    if(rv == OSMP_FAILURE){
+        OSMP_Finalize();
+        printf("OSMP_SendAlloc returned error for rank %d with destination %d\n", rank, dest);
+        return -1;
+    }
+    // Ein noch nicht versendeter Block darf nicht wie ein empfangener freigegeben werden
+    if(OSMP_RecvRelease(payload) != OSMP_FAILURE){
+        OSMP_Finalize();
+        printf("OSMP_RecvRelease accepted an uncommitted block for rank %d\n", rank);
+        return -1;
+    }
+    payload[0] = rank;
+    payload[1] = rank * rank;
+    rv = OSMP_SendCommit(payload);
+    if(rv == OSMP_FAILURE){
+        OSMP_Finalize();
+        printf("OSMP_SendCommit returned error for rank %d\n", rank);
+        return -1;
+    }
+    // Ein bereits versendeter Block darf kein zweites Mal veröffentlicht werden
+    if(OSMP_SendCommit(payload) != OSMP_FAILURE){
+        OSMP_Finalize();
+        printf("OSMP_SendCommit accepted a committed block for rank %d\n", rank);
+        return -1;
+    }
+
+    int bufout[2];
+    rv = OSMP_Recv(bufout, 2, OSMP_INT, &source, &len);
+    if(rv == OSMP_FAILURE || bufout[0] != source || bufout[1] != source * source){
+        OSMP_Finalize();
+        printf("OSMP_Recv returned error or wrong data for rank %d\n", rank);
+        return -1;
+    }
+    printf("OSMP process %d received [%d:%d] from %d\n", rank, bufout[0], bufout[1], source);
+
+    // Ein geliehener Block gehört noch zur empfangenen Nachricht und darf nicht versendet werden
+    int message[BORROW_INTS];
+    for(int i = 0; i < BORROW_INTS; i++) {
+        message[i] = rank + i;
+    }
+    int *borrowed;
+    if(OSMP_Send(message, BORROW_INTS, OSMP_INT, dest) == OSMP_FAILURE
+       || OSMP_RecvBorrow((void **) &borrowed, &len, &source) == OSMP_FAILURE
+       || len != (int)sizeof(message) || borrowed[BORROW_INTS - 1] != source + BORROW_INTS - 1
+       || OSMP_SendCommit(borrowed) != OSMP_FAILURE || OSMP_RecvRelease(borrowed) == OSMP_FAILURE
+       || OSMP_RecvRelease(borrowed) != OSMP_FAILURE){
+        OSMP_Finalize();
+        printf("Borrowed block was not protected for rank %d\n", rank);
+        return -1;
+    }
+
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+* FILE: osmpExecutable_SendBatch.c
+* DESCRIPTION:
+* OSMP program in which every rank sends a batch of messages of different
+* sizes to rank 0, which checks that each sender's messages arrive complete
+* and in order
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define BATCH 40
+#define LARGE_INDEX 20
+#define LARGE_COUNT (32 * 1024)
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, tag, len;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+
+    // Mehr Nachrichten als ein Postfach fasst, dazwischen eine Nachricht oberhalb der Rendezvous-Schwelle
+    int *buffers[BATCH];
+    OSMP_Msg msgs[BATCH];
+    for(int i = 0; i < BATCH; i++) {
+        int count = i == LARGE_INDEX ? LARGE_COUNT : 2 + i % 5;
+        buffers[i] = malloc(sizeof(int) * (size_t)count);
+        if(buffers[i] == NULL) {
+            printf("malloc failed for rank %d\n", rank);
+            return -1;
+        }
+        for(int k = 0; k < count; k++) {
+            buffers[i][k] = rank * 100000 + i * 1000 + k % 1000;
+        }
+        msgs[i].buf = buffers[i];
+        msgs[i].count = count;
+        msgs[i].datatype = OSMP_INT;
+        msgs[i].tag = i % 3;
+    }
+
+    if(rank != 0) {
+        rv = OSMP_SendBatch(msgs, BATCH, 0);
+        if(rv == OSMP_FAILURE){
+            OSMP_Finalize();
+            printf("OSMP_SendBatch returned error for rank %d\n", rank);
+            return -1;
+        }
+    } else {
+        int errors = 0;
+        int *buf = malloc(sizeof(int) * LARGE_COUNT);
+        if(buf == NULL) {
+            printf("malloc failed for rank %d\n", rank);
+            return -1;
+        }
+        for(int s = 1; s < size; s++) {
+            for(int i = 0; i < BATCH; i++) {
+                int count = i == LARGE_INDEX ? LARGE_COUNT : 2 + i % 5;
+                rv = OSMP_RecvFrom(buf, LARGE_COUNT, OSMP_INT, s, OSMP_ANY_TAG, &source, &tag, &len);
+                if(rv == OSMP_FAILURE || source != s || tag != i % 3 || len != count * (int)sizeof(int)) {
+                    errors++;
+                    continue;
+                }
+                for(int k = 0; k < count; k++) {
+                    if(buf[k] != s * 100000 + i * 1000 + k % 1000) {
+                        errors++;
+                        break;
+                    }
+                }
+            }
+        }
+        free(buf);
+        printf("OSMP process %d received %d messages, %d mismatched\n", rank, BATCH * (size - 1), errors);
+        if(errors != 0) {
+            OSMP_Finalize();
+            return -1;
+        }
+    }
+
+    for(int i = 0; i < BATCH; i++) {
+        free(buffers[i]);
+    }
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+* FILE: osmpExecutable_SendRecvLarge.c
+* DESCRIPTION:
+* OSMP program that sends messages larger than OSMP_MAX_PAYLOAD_LENGTH from
+* every rank to rank 0, which receives them alternately with OSMP_Recv and
+* OSMP_RecvBorrow
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define NUMBER_OF_SIZES 3
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, len;
+    int sizes[NUMBER_OF_SIZES] = {OSMP_MAX_PAYLOAD_LENGTH + 1, 3 * OSMP_MAX_PAYLOAD_LENGTH + 7, 8 * OSMP_MAX_PAYLOAD_LENGTH};
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+
+    unsigned char *buf = malloc((size_t) sizes[NUMBER_OF_SIZES - 1]);
+    if(buf == NULL){
+        OSMP_Finalize();
+        printf("malloc failed for rank %d\n", rank);
+        return -1;
+    }
+
+    if(rank != 0) {
+        for(int i = 0; i < NUMBER_OF_SIZES; i++) {
+            // Muster aus Rang und Position, damit der Empfänger den Inhalt prüfen kann
+            for(int j = 0; j < sizes[i]; j++) {
+                buf[j] = (unsigned char) (rank + j);
+            }
+            rv = OSMP_Send(buf, sizes[i], OSMP_BYTE, 0);
+            if(rv == OSMP_FAILURE){
+                OSMP_Finalize();
+                printf("OSMP_Send returned error for rank %d with %d bytes\n", rank, sizes[i]);
+                return -1;
+            }
+        }
+    } else {
+        int errors = 0;
+        for(int i = 0; i < (size - 1) * NUMBER_OF_SIZES; i++) {
+            unsigned char *message = buf;
+            if(i % 2 == 0) {
+                rv = OSMP_Recv(buf, sizes[NUMBER_OF_SIZES - 1], OSMP_BYTE, &source, &len);
+            } else {
+                rv = OSMP_RecvBorrow((void **) &message, &len, &source);
+            }
+            if(rv == OSMP_FAILURE){
+                OSMP_Finalize();
+                printf("Receive returned error for rank %d\n", rank);
+                return -1;
+            }
+            for(int j = 0; j < len; j++) {
+                if(message[j] != (unsigned char) (source + j)) {
+                    errors++;
+                    break;
+                }
+            }
+            if(message != buf && OSMP_RecvRelease(message) == OSMP_FAILURE) {
+                errors++;
+            }
+        }
+        printf("OSMP process %d received %d messages, %d corrupted\n", rank, (size - 1) * NUMBER_OF_SIZES, errors);
+        if(errors != 0) {
+            OSMP_Finalize();
+            return -1;
+        }
+    }
+    free(buf);
+
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
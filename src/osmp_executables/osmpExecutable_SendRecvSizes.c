@@ -0,0 +1,88 @@
+/******************************************************************************
+* FILE: osmpExecutable_SendRecvSizes.c
+* DESCRIPTION:
+* OSMP program that sends messages of different sizes from every rank to rank 0
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define NUMBER_OF_SIZES 6
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank, source, len;
+    int sizes[NUMBER_OF_SIZES] = {8, 64, 1000, 5000, 100000, OSMP_MAX_PAYLOAD_LENGTH};
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+
+    // Der Puffer muss die längste Nachricht fassen, auch wenn sie über der maximalen Nutzlast liegt
+    int largest = 0;
+    for(int i = 0; i < NUMBER_OF_SIZES; i++) {
+        largest = sizes[i] > largest ? sizes[i] : largest;
+    }
+    unsigned char *buf = malloc((size_t) largest);
+    if(buf == NULL){
+        OSMP_Finalize();
+        printf("malloc failed for rank %d\n", rank);
+        return -1;
+    }
+
+    if(rank != 0) {
+        for(int i = 0; i < NUMBER_OF_SIZES; i++) {
+            // Muster aus Rang und Position, damit der Empfänger den Inhalt prüfen kann
+            for(int j = 0; j < sizes[i]; j++) {
+                buf[j] = (unsigned char) (rank + j);
+            }
+            rv = OSMP_Send(buf, sizes[i], OSMP_BYTE, 0);
+            if(rv == OSMP_FAILURE){
+                OSMP_Finalize();
+                printf("OSMP_Send returned error for rank %d with %d bytes\n", rank, sizes[i]);
+                return -1;
+            }
+        }
+    } else {
+        int errors = 0;
+        for(int i = 0; i < (size - 1) * NUMBER_OF_SIZES; i++) {
+            rv = OSMP_Recv(buf, largest, OSMP_BYTE, &source, &len);
+            if(rv == OSMP_FAILURE){
+                OSMP_Finalize();
+                printf("OSMP_Recv returned error for rank %d\n", rank);
+                return -1;
+            }
+            for(int j = 0; j < len; j++) {
+                if(buf[j] != (unsigned char) (source + j)) {
+                    errors++;
+                    break;
+                }
+            }
+        }
+        printf("OSMP process %d received %d messages, %d corrupted\n", rank, (size - 1) * NUMBER_OF_SIZES, errors);
+        if(errors != 0) {
+            OSMP_Finalize();
+            return -1;
+        }
+    }
+    free(buf);
+
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,180 @@
+/******************************************************************************
+* FILE: osmpExecutable_WaitAny.c
+* DESCRIPTION:
+* OSMP program for OSMP_Waitany, OSMP_Waitall, OSMP_Testall and OSMP_Testsome.
+* Rank 0 posts several receives and collects them with OSMP_Waitany(), which
+* must report them in the order they completed. Rank 1 starts its sends in
+* reverse order and checks that OSMP_Testsome() lists them the same way.
+* Finally, rank 0 waits with OSMP_Waitall() for receives that are listed
+* first but complete only after its sends, which rank 1 receives before it
+* answers.
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../osmp_library/OSMP.h"
+
+#define COUNT 8
+
+int main(int argc, char *argv[]) {
+    int rv, size, rank;
+    rv = OSMP_Init(&argc, &argv);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Init: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Size(&size);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Size: returned error number %d\n", rv);
+        return -1;
+    }
+    rv = OSMP_Rank(&rank);
+    if(rv != OSMP_SUCCESS){
+        printf("OSMP_Rank: returned error number %d\n", rv);
+        return -1;
+    }
+    if (size != 2) {
+        printf("You have to start runner with 2 processes exactly.\n");
+        OSMP_Finalize();
+        return -1;
+    }
+
+    int errors = 0;
+    int values[COUNT], sources[COUNT], lens[COUNT], indices[COUNT + 1];
+    int index, outcount, flag;
+    int answers[COUNT], answer_sources[COUNT], answer_lens[COUNT];
+    // Empfänge stehen vorne, schließen aber erst nach den Sendungen dahinter ab
+    OSMP_Request exchange[2 * COUNT];
+    // Der letzte Eintrag bleibt NULL und muss übergangen werden
+    OSMP_Request requests[COUNT + 1];
+    requests[COUNT] = NULL;
+    for(int i = 0; i < COUNT; i++) {
+        if(OSMP_CreateRequest(&requests[i]) != OSMP_SUCCESS || OSMP_CreateRequest(&exchange[i]) != OSMP_SUCCESS
+           || OSMP_CreateRequest(&exchange[COUNT + i]) != OSMP_SUCCESS) {
+            printf("OSMP process %d couldn't create requests\n", rank);
+            return -1;
+        }
+    }
+
+    if(rank == 0) {
+        // Empfänge werden in der Reihenfolge ihres Starts bedient
+        for(int i = 0; i < COUNT; i++) {
+            values[i] = -1;
+            if(OSMP_IRecv(&values[i], 1, OSMP_INT, &sources[i], &lens[i], requests[i]) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+        OSMP_Barrier();
+        for(int i = 0; i < COUNT; i++) {
+            rv = OSMP_Waitany(COUNT + 1, requests, &index);
+            if(rv != OSMP_SUCCESS || index != i || values[i] != 10 * (COUNT - 1 - i) || sources[i] != 1) {
+                errors++;
+            }
+        }
+        if(OSMP_Waitany(COUNT + 1, requests, &index) != OSMP_SUCCESS || index != OSMP_UNDEFINED) {
+            errors++;
+        }
+        printf("OSMP process %d collected %d receives with OSMP_Waitany\n", rank, COUNT);
+    } else {
+        OSMP_Barrier();
+        // Die Sendungen werden rückwärts gestartet und schließen daher rückwärts ab
+        for(int i = COUNT - 1; i >= 0; i--) {
+            values[i] = 10 * i;
+            if(OSMP_ISend(&values[i], 1, OSMP_INT, 0, requests[i]) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+        if(OSMP_Waitall(COUNT + 1, requests) != OSMP_SUCCESS
+           || OSMP_Testall(COUNT + 1, requests, &flag) != OSMP_SUCCESS || flag != OSMP_DONE) {
+            errors++;
+        }
+        rv = OSMP_Testsome(COUNT + 1, requests, &outcount, indices);
+        if(rv != OSMP_SUCCESS || outcount != COUNT) {
+            errors++;
+        } else {
+            for(int i = 0; i < COUNT; i++) {
+                if(indices[i] != COUNT - 1 - i) {
+                    errors++;
+                }
+            }
+        }
+        // Alle Fertigstellungen sind gemeldet
+        if(OSMP_Testsome(COUNT + 1, requests, &outcount, indices) != OSMP_SUCCESS || outcount != OSMP_UNDEFINED) {
+            errors++;
+        }
+        printf("OSMP process %d collected %d sends with OSMP_Testsome\n", rank, COUNT);
+    }
+
+    if(rank == 0) {
+        for(int i = 0; i < COUNT; i++) {
+            answers[i] = -1;
+            if(OSMP_IRecv(&answers[i], 1, OSMP_INT, &answer_sources[i], &answer_lens[i], exchange[i]) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+        for(int i = 0; i < COUNT; i++) {
+            values[i] = i;
+            if(OSMP_ISend(&values[i], 1, OSMP_INT, 1, exchange[COUNT + i]) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+        if(OSMP_Waitall(2 * COUNT, exchange) != OSMP_SUCCESS
+           || OSMP_Testall(2 * COUNT, exchange, &flag) != OSMP_SUCCESS || flag != OSMP_DONE) {
+            errors++;
+        }
+        for(int i = 0; i < COUNT; i++) {
+            if(answers[i] != 100 + i || answer_sources[i] != 1 || answer_lens[i] != (int)sizeof(int)) {
+                errors++;
+            }
+        }
+        // Die Sendungen sind vor den Empfängen fertig geworden
+        for(int i = 0; i < 2 * COUNT; i++) {
+            rv = OSMP_Waitany(2 * COUNT, exchange, &index);
+            if(rv != OSMP_SUCCESS || index != (COUNT + i) % (2 * COUNT)) {
+                errors++;
+            }
+        }
+        printf("OSMP process %d collected %d out-of-order requests with OSMP_Waitall\n", rank, 2 * COUNT);
+    } else {
+        int value, source, len;
+        for(int i = 0; i < COUNT; i++) {
+            if(OSMP_Recv(&value, 1, OSMP_INT, &source, &len) != OSMP_SUCCESS || value != i) {
+                errors++;
+            }
+        }
+        for(int i = 0; i < COUNT; i++) {
+            value = 100 + i;
+            if(OSMP_Send(&value, 1, OSMP_INT, 0) != OSMP_SUCCESS) {
+                errors++;
+            }
+        }
+    }
+
+    // Eine gebundene, aber nie gestartete Request steht nicht aus
+    OSMP_Request bound;
+    if(OSMP_CreateRequest(&bound) != OSMP_SUCCESS || OSMP_Send_init(values, 1, OSMP_INT, 1 - rank, bound) != OSMP_SUCCESS
+       || OSMP_Waitany(1, &bound, &index) != OSMP_SUCCESS || index != OSMP_UNDEFINED
+       || OSMP_RemoveRequest(&bound) != OSMP_SUCCESS || bound != NULL) {
+        errors++;
+    }
+
+    for(int i = 0; i < COUNT; i++) {
+        if(OSMP_RemoveRequest(&requests[i]) != OSMP_SUCCESS || OSMP_RemoveRequest(&exchange[i]) != OSMP_SUCCESS
+           || OSMP_RemoveRequest(&exchange[COUNT + i]) != OSMP_SUCCESS) {
+            errors++;
+        }
+    }
+
+    if(errors != 0) {
+        printf("OSMP process %d: %d errors\n", rank, errors);
+        OSMP_Finalize();
+        return -1;
+    }
+    rv = OSMP_Finalize();
+    if(rv == OSMP_FAILURE){
+        printf("OSMP_Finalize returned error for rank %d\n", rank);
+        return -1;
+    }
+
+    return 0;
+}
@@ -23,19 +23,34 @@
 typedef void* OSMP_Request;
 
 /**
- * Die maximale Zahl der Nachrichten pro Prozess 
+ * Standardwert für die maximale Zahl der Nachrichten pro Prozess. osmp_run -Q legt einen anderen Wert fest; den
+ * tatsächlichen Wert liefert get_OSMP_MAX_MESSAGES_PROC().
  */
 #define OSMP_MAX_MESSAGES_PROC 16
 
 /**
- * Die maximale Anzahl der Nachrichten, die insgesamt vorhanden sein dürfen
+ * Standardwert für die maximale Anzahl der Nachrichten, die insgesamt vorhanden sein dürfen. osmp_run -S legt einen
+ * anderen Wert fest; den tatsächlichen Wert liefert get_OSMP_MAX_SLOTS().
  */
 #define OSMP_MAX_SLOTS 256
 
 /**
- * Die maximale Länge der Nutzlast einer Nachricht
+ * Standardwert für die maximale Länge der Nutzlast einer Nachricht (Blockgröße der größten Größenklasse des Heaps).
+ * Jeder Prozess vergrößert den Shared Memory um mindestens einen Block dieser Größe; längere Nachrichten werden in
+ * Teilstücken oder per Rendezvous übertragen und warten dabei auf den Empfänger. osmp_run -P legt einen anderen Wert
+ * fest; den tatsächlichen Wert liefert get_OSMP_MAX_PAYLOAD_LENGTH().
  */
-#define OSMP_MAX_PAYLOAD_LENGTH 1024
+#define OSMP_MAX_PAYLOAD_LENGTH (128 * 1024)
+
+/**
+ * Platzhalter für OSMP_RecvFrom(), der Nachrichten von beliebigen Sendern annimmt.
+ */
+#define OSMP_ANY_SOURCE (-1)
+
+/**
+ * Platzhalter für OSMP_RecvFrom(), der Nachrichten mit beliebigem Tag annimmt.
+ */
+#define OSMP_ANY_TAG (-1)
 
 /**
  * Gibt an, dass eine nicht-blockierende Funktion (ISend/IRecv) abgeschlossen ist.
@@ -47,6 +62,11 @@ typedef void* OSMP_Request;
  */
 #define OSMP_WAITING 0
 
+/**
+ * Index bzw. Anzahl, die OSMP_Waitany() und OSMP_Testsome() liefern, wenn keine der übergebenen Requests aktiv ist.
+ */
+#define OSMP_UNDEFINED (-1)
+
 /**
  * Die OSMP-Datentypen entsprechen den C-Datentypen. 
  * Sie werden verwendet, um den Typ der Daten anzugeben, die mit den OSMP-Funktionen gesendet bzw. empfangen werden sollen.
@@ -65,17 +85,30 @@ typedef enum OSMP_Datatype {
 } OSMP_Datatype;
 
 /**
- * Gibt die maximale Länge der Nutzlast einer Nachricht zurück.
+ * Beschreibt eine einzelne Nachricht für OSMP_SendBatch().
+ */
+typedef struct OSMP_Msg {
+    const void *buf;        // Startadresse des Puffers mit der Nachricht
+    int count;              // Zahl der Elemente vom angegebenen Typ im Puffer
+    OSMP_Datatype datatype; // OSMP-Typ der Daten im Puffer
+    int tag;                // Tag der Nachricht (nicht negativ)
+} OSMP_Msg;
+
+/**
+ * Gibt die maximale Länge der Nutzlast einer Nachricht zurück, mit der osmp_run gestartet wurde. Darf erst nach
+ * OSMP_Init() aufgerufen werden.
  */
 int get_OSMP_MAX_PAYLOAD_LENGTH(void);
 
 /**
- * Gibt die Maximale Anzahl der Nachrichten, die insgesamt vorhanden sein dürfen zurück. 
+ * Gibt die Maximale Anzahl der Nachrichten, die insgesamt vorhanden sein dürfen zurück, mit der osmp_run gestartet
+ * wurde. Darf erst nach OSMP_Init() aufgerufen werden.
  */
 int get_OSMP_MAX_SLOTS(void);
 
 /**
- * Gibt die maximale Zahl der Nachrichten pro Prozess zurück.
+ * Gibt die maximale Zahl der Nachrichten pro Prozess zurück, mit der osmp_run gestartet wurde. Darf erst nach
+ * OSMP_Init() aufgerufen werden.
  */
 int get_OSMP_MAX_MESSAGES_PROC(void);
 
@@ -135,6 +168,11 @@ int OSMP_Rank(int *rank);
  * Die Nachricht besteht aus count Elementen vom Typ datatype. 
  * Die zu sendende Nachricht beginnt im aufrufenden Prozess bei der Adresse buf.
  * Die Funktion ist blockierend, d.h. wenn sie in das aufrufende Programm zurückkehrt, ist der Kopiervorgang abgeschlossen.
+ * Nachrichten mit mehr als get_OSMP_MAX_PAYLOAD_LENGTH() Bytes werden in Teilstücken übertragen, die der Empfänger
+ * bereits liest, während weitere geschrieben werden. In diesem Fall kehrt die Funktion erst zurück, wenn der Empfänger die
+ * Nachricht bis auf die letzten Teilstücke entgegengenommen hat. Sind solche Nachrichten mindestens 64 KiB lang, liest
+ * der Empfänger sie nach Möglichkeit direkt aus dem Puffer des Senders; die Funktion kehrt dann erst nach dem Empfang
+ * zurück. Nachrichten bis get_OSMP_MAX_PAYLOAD_LENGTH() Bytes werden immer gepuffert, ohne auf den Empfänger zu warten.
  *
  * @param [in] buf      Startadresse des Puffers mit der zu sendenden Nachricht
  * @param [in] count    Zahl der Elemente vom angegebenen Typ im Puffer
@@ -163,6 +201,155 @@ int OSMP_Send(const void *buf, int count, OSMP_Datatype datatype, int dest);
  */
 int OSMP_Recv(void *buf, int count, OSMP_Datatype datatype, int *source, int *len);
 
+/**
+ * Die Funktion sendet eine Nachricht analog zu OSMP_Send() und versieht sie mit dem Tag tag, über das der Empfänger
+ * mit OSMP_RecvFrom() gezielt Nachrichten auswählen kann. OSMP_Send() sendet mit dem Tag 0.
+ *
+ * @param [in] buf      Startadresse des Puffers mit der zu sendenden Nachricht
+ * @param [in] count    Zahl der Elemente vom angegebenen Typ im Puffer
+ * @param [in] datatype OSMP-Typ der Daten im Puffer
+ * @param [in] dest     Nummer des Empfängers zwischen 0,…,np-1
+ * @param [in] tag      Tag der Nachricht (nicht negativ)
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_SendTag(const void *buf, int count, OSMP_Datatype datatype, int dest, int tag);
+
+/**
+ * Die Funktion empfängt analog zu OSMP_Recv() die älteste Nachricht, die vom Sender source stammt und das Tag tag
+ * trägt. Mit OSMP_ANY_SOURCE bzw. OSMP_ANY_TAG wird jeder Sender bzw. jedes Tag akzeptiert. Nachrichten, die nicht
+ * passen, bleiben in Ankunftsreihenfolge für spätere Aufrufe erhalten.
+ *
+ * @param [out] buf           Startadresse des Puffers, in den die Nachricht kopiert werden soll
+ * @param [in]  count         maximale Zahl der Elemente vom angegebenen Typ, die empfangen werden können
+ * @param [in]  datatype      OSMP-Typ der Daten im Puffer
+ * @param [in]  source        Nummer des gewünschten Senders zwischen 0,…,np-1 oder OSMP_ANY_SOURCE
+ * @param [in]  tag           gewünschtes Tag oder OSMP_ANY_TAG
+ * @param [out] actual_source Nummer des tatsächlichen Senders
+ * @param [out] actual_tag    Tag der empfangenen Nachricht
+ * @param [out] len           tatsächliche Länge der empfangenen Nachricht in Byte
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_RecvFrom(void *buf, int count, OSMP_Datatype datatype, int source, int tag, int *actual_source,
+                  int *actual_tag, int *len);
+
+/**
+ * Die Funktion wartet, bis eine Nachricht vom Sender source mit dem Tag tag vorliegt, und liefert deren Sender, Tag und
+ * Länge, ohne sie zu empfangen. Die Nachricht kann danach mit OSMP_RecvFrom() in einem Puffer passender Größe
+ * empfangen werden. OSMP_ANY_SOURCE und OSMP_ANY_TAG sind wie bei OSMP_RecvFrom() erlaubt.
+ *
+ * @param [in]  source        Nummer des gewünschten Senders zwischen 0,…,np-1 oder OSMP_ANY_SOURCE
+ * @param [in]  tag           gewünschtes Tag oder OSMP_ANY_TAG
+ * @param [out] actual_source Nummer des Senders der gefundenen Nachricht
+ * @param [out] actual_tag    Tag der gefundenen Nachricht
+ * @param [out] len           Länge der gefundenen Nachricht in Byte
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Probe(int source, int tag, int *actual_source, int *actual_tag, int *len);
+
+/**
+ * Die Funktion arbeitet wie OSMP_Probe(), kehrt aber sofort zurück. Liegt keine passende Nachricht vor, wird *flag auf
+ * 0 gesetzt und die übrigen Ausgabeparameter bleiben unverändert; sonst wird *flag auf 1 gesetzt.
+ *
+ * @param [in]  source        Nummer des gewünschten Senders zwischen 0,…,np-1 oder OSMP_ANY_SOURCE
+ * @param [in]  tag           gewünschtes Tag oder OSMP_ANY_TAG
+ * @param [out] flag          1, wenn eine passende Nachricht vorliegt, sonst 0
+ * @param [out] actual_source Nummer des Senders der gefundenen Nachricht
+ * @param [out] actual_tag    Tag der gefundenen Nachricht
+ * @param [out] len           Länge der gefundenen Nachricht in Byte
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Iprobe(int source, int tag, int *flag, int *actual_source, int *actual_tag, int *len);
+
+/**
+ * Die Funktion OSMP_SendBatch() sendet die n Nachrichten aus msgs in dieser Reihenfolge an den Prozess dest. Für
+ * aufeinanderfolgende Nachrichten, die in einen Nachrichtenslot passen, werden Nachrichtenslots und Postfach-Einträge
+ * gemeinsam reserviert und mit einem einzigen Wecken des Empfängers veröffentlicht, sodass die Synchronisationskosten
+ * einmal pro Stapel statt einmal pro Nachricht anfallen. Größere Nachrichten werden wie mit OSMP_SendTag() einzeln
+ * gesendet.
+ * Die Funktion ist blockierend, d.h. sie wartet, bis alle Nachrichten in das Postfach des Empfängers gestellt wurden.
+ *
+ * @param [in] msgs Feld mit n Nachrichtenbeschreibungen
+ * @param [in] n    Zahl der Nachrichten (mindestens 1)
+ * @param [in] dest Nummer des Empfängers zwischen 0,…,np-1
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE (ist eine Nachrichtenbeschreibung ungültig, wird keine
+ * Nachricht gesendet)
+ */
+int OSMP_SendBatch(const OSMP_Msg *msgs, int n, int dest);
+
+/**
+ * Die Funktion OSMP_RecvMany() empfängt in einem Durchgang alle Nachrichten, die für den aufrufenden Prozess vorliegen,
+ * höchstens aber maxn, in der Reihenfolge ihres Eintreffens. Die i-te Nachricht wird nach bufs[i] kopiert; unter
+ * sources[i] wird die OSMP-Prozessnummer ihres Senders und unter lens[i] ihre tatsächliche Länge abgelegt. Die
+ * Nachrichtenslots aller gelesenen Nachrichten werden gemeinsam freigegeben.
+ * Die Funktion ist blockierend, d.h. sie wartet, bis mindestens eine Nachricht für den Prozess vorhanden ist.
+ *
+ * @param [out] bufs     Feld mit maxn Puffern, in die die Nachrichten kopiert werden
+ * @param [in]  count    maximale Zahl der Elemente vom angegebenen Typ, die jeder Puffer aufnehmen kann
+ * @param [in]  datatype OSMP-Typ der Daten in den Puffern
+ * @param [in]  maxn     maximale Zahl der zu empfangenden Nachrichten
+ * @param [out] got      Zahl der empfangenen Nachrichten (mindestens 1)
+ * @param [out] sources  Feld für die Nummern der Sender (darf NULL sein)
+ * @param [out] lens     Feld für die Längen der Nachrichten in Byte (darf NULL sein)
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_RecvMany(void **bufs, int count, OSMP_Datatype datatype, int maxn, int *got, int *sources, int *lens);
+
+/**
+ * Die Funktion OSMP_SendAlloc() reserviert einen Nachrichtenslot für eine Nachricht mit len Bytes an den Prozess dest
+ * und liefert in *ptr* einen Zeiger auf dessen Nutzlast im Shared Memory. Der Aufrufer kann die Nachricht dort direkt
+ * aufbauen und sie anschließend mit OSMP_SendCommit() versenden, ohne dass sie ein weiteres Mal kopiert wird.
+ * Die Funktion ist blockierend, d.h. sie wartet, bis ein Nachrichtenslot frei ist.
+ *
+ * @param [in]  dest Nummer des Empfängers zwischen 0,…,np-1
+ * @param [in]  len  Länge der Nachricht in Byte (höchstens get_OSMP_MAX_PAYLOAD_LENGTH())
+ * @param [out] ptr  Zeiger auf die Nutzlast des reservierten Nachrichtenslots
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_SendAlloc(int dest, int len, void **ptr);
+
+/**
+ * Die Funktion OSMP_SendCommit() versendet eine mit OSMP_SendAlloc() reservierte Nachricht an ihren Empfänger.
+ * Nach dem Aufruf darf der Zeiger nicht mehr verwendet werden.
+ *
+ * @param [in] ptr Zeiger, den OSMP_SendAlloc() geliefert hat
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE (auch, wenn ptr nicht von OSMP_SendAlloc() stammt oder
+ * bereits versendet wurde)
+ */
+int OSMP_SendCommit(void *ptr);
+
+/**
+ * Die Funktion OSMP_RecvBorrow() empfängt die nächste Nachricht, ohne sie zu kopieren. In *ptr* wird ein Zeiger auf
+ * die Nutzlast im Shared Memory geliefert, unter len die Länge der Nachricht in Byte und unter source die
+ * OSMP-Prozessnummer des Senders. Der Nachrichtenslot bleibt belegt, bis er mit OSMP_RecvRelease() freigegeben wird.
+ * Die Funktion ist blockierend, d.h. sie wartet, bis eine Nachricht für den Prozess vorhanden ist.
+ *
+ * @param [out] ptr    Zeiger auf die Nutzlast der empfangenen Nachricht
+ * @param [out] len    tatsächliche Länge der empfangenen Nachricht in Byte
+ * @param [out] source Nummer des Senders zwischen 0,…,np-1
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_RecvBorrow(void **ptr, int *len, int *source);
+
+/**
+ * Die Funktion OSMP_RecvRelease() gibt den Nachrichtenslot einer mit OSMP_RecvBorrow() empfangenen Nachricht frei.
+ * Die Nachricht gilt danach als abgearbeitet, der Zeiger darf nicht mehr verwendet werden.
+ *
+ * @param [in] ptr Zeiger, den OSMP_RecvBorrow() geliefert hat
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE (auch, wenn ptr nicht von OSMP_RecvBorrow() stammt oder
+ * bereits freigegeben wurde)
+ */
+int OSMP_RecvRelease(void *ptr);
+
 /**
  * Alle OSMP-Prozesse müssen diese Funktion aufrufen, bevor sie sich beenden. 
  * Sie geben damit den Zugriff auf die gemeinsamen Ressourcen frei.
@@ -199,6 +386,7 @@ int OSMP_Gather(void *sendbuf, int sendcount, OSMP_Datatype sendtype, void *recv
 /**
  * Die Funktion sendet eine Nachricht analog zu OSMP_Send(). 
  * Die Funktion kehrt jedoch sofort zurück, ohne dass das Kopieren der Nachricht sichergestellt ist (nicht blockierendes Senden).
+ * Nicht blockierende Sendungen an denselben Empfänger werden in der Reihenfolge ihrer Aufrufe ausgeführt.
  *
  * @param [in]      buf Startadresse des Puffers mit der zu sendenden Nachricht
  * @param [in]      count Zahl der Elemente vom angegebenen Typ im Puffer
@@ -213,6 +401,9 @@ int OSMP_ISend(const void *buf, int count, OSMP_Datatype datatype, int dest, OSM
 /**
  * Die Funktion empfängt eine Nachricht analog zu OSMP_Recv().
  * Die Funktion kehrt jedoch sofort zurück, ohne dass das Kopieren der Nachricht sichergestellt ist (nicht blockierendes Empfangen).
+ * Nicht blockierende Empfänge werden in der Reihenfolge ihrer Aufrufe bedient. Ist der Empfang bereitgestellt, bevor
+ * die Nachricht gesendet wird, schreibt der Sender sie direkt in *buf*; der Puffer darf daher bis zum Abschluss nicht
+ * anderweitig verwendet werden.
  *
  * @param [out]     buf Startadresse des Speicherbereichs, wo die zu empfangende Nachricht gespeichert werden soll.
  * @param [in]      count Zahl der Elemente vom angegebenen Typ, die empfangen werden können
@@ -257,14 +448,137 @@ int OSMP_Wait(OSMP_Request request);
 int OSMP_CreateRequest(OSMP_Request *request);
 
 /**
- * Löscht eine OSMP_Request.
+ * Löscht eine OSMP_Request. Läuft noch eine Operation der Request, wird auf ihren Abschluss gewartet. Anschließend
+ * wird *request* auf NULL gesetzt.
  *
- * @param [in] request Adresse eines Requests
+ * @param [in, out] request Adresse eines Requests
  *
  * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
  */
 int OSMP_RemoveRequest(OSMP_Request *request);
 
+/**
+ * Die Funktion bindet ein Senden analog zu OSMP_Send() dauerhaft an eine mit OSMP_CreateRequest() erzeugte Request.
+ * Puffer, Anzahl, Typ und Empfänger werden einmalig geprüft; jeder Aufruf von OSMP_Start() sendet danach den aktuellen
+ * Inhalt des Puffers, ohne dass erneut Verwaltungsaufwand entsteht. Bis zum ersten Start gilt die Request als
+ * abgeschlossen. Die Request kann nicht mehr mit OSMP_ISend() oder OSMP_IRecv() verwendet werden.
+ *
+ * @param [in]      buf Startadresse des Puffers mit der zu sendenden Nachricht
+ * @param [in]      count Zahl der Elemente vom angegebenen Typ im Puffer
+ * @param [in]      datatype OSMP-Typ der Daten im Puffer
+ * @param [in]      dest Nummer des Empfängers zwischen 0, …, np-1
+ * @param [in, out] request Request, an die das Senden gebunden wird
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Send_init(const void *buf, int count, OSMP_Datatype datatype, int dest, OSMP_Request request);
+
+/**
+ * Die Funktion bindet ein Empfangen analog zu OSMP_Recv() dauerhaft an eine mit OSMP_CreateRequest() erzeugte
+ * Request. Jeder Aufruf von OSMP_Start() empfängt danach die nächste Nachricht in den Puffer und schreibt Sender und
+ * Länge nach *source* und *len*.
+ *
+ * @param [out]     buf Startadresse des Speicherbereichs, wo die zu empfangenden Nachrichten gespeichert werden sollen
+ * @param [in]      count Zahl der Elemente vom angegebenen Typ, die empfangen werden können
+ * @param [in]      datatype OSMP-Typ der Daten im Puffer
+ * @param [out]     source Nummer des Senders der zuletzt empfangenen Nachricht
+ * @param [out]     len tatsächliche Länge der zuletzt empfangenen Nachricht in Byte
+ * @param [in, out] request Request, an die das Empfangen gebunden wird
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Recv_init(void *buf, int count, OSMP_Datatype datatype, int *source, int *len, OSMP_Request request);
+
+/**
+ * Die Funktion startet die an eine persistente Request gebundene Operation erneut und kehrt sofort zurück. Der
+ * Abschluss wird wie bei OSMP_ISend()/OSMP_IRecv() mit OSMP_Test() oder OSMP_Wait() abgefragt. Eine Request kann
+ * erst wieder gestartet werden, wenn ihre vorherige Operation abgeschlossen ist.
+ *
+ * @param [in] request Mit OSMP_Send_init() oder OSMP_Recv_init() gebundene Request
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Start(OSMP_Request request);
+
+/**
+ * Die Funktion startet mehrere persistente Requests wie OSMP_Start(). Ist eine der Requests ungültig oder noch aktiv,
+ * wird keine gestartet.
+ *
+ * @param [in] count Anzahl der Requests
+ * @param [in] requests Feld mit count persistenten Requests
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Startall(int count, OSMP_Request *requests);
+
+/**
+ * Die Funktion wartet, bis alle übergebenen Requests abgeschlossen sind. NULL-Einträge und Requests, die noch nie
+ * gestartet wurden, werden übergangen.
+ *
+ * @param [in] count Anzahl der Requests
+ * @param [in] requests Feld mit count Requests
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Waitall(int count, OSMP_Request *requests);
+
+/**
+ * Die Funktion wartet, bis eine der übergebenen Requests abgeschlossen ist, und liefert deren Index. Liegen mehrere
+ * Fertigstellungen vor, wird die älteste geliefert. Jede Fertigstellung wird von OSMP_Waitany() und OSMP_Testsome()
+ * nur einmal gemeldet, bis die Request erneut gestartet wird; NULL-Einträge und nie gestartete Requests werden
+ * übergangen. Der Aufrufer schläft, bis eine beliebige Request des Prozesses fertig wird, und nicht für jede Request
+ * einzeln.
+ *
+ * @param [in]  count Anzahl der Requests
+ * @param [in]  requests Feld mit count Requests
+ * @param [out] index Index der abgeschlossenen Request oder OSMP_UNDEFINED, wenn keine Request mehr aussteht
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Waitany(int count, OSMP_Request *requests, int *index);
+
+/**
+ * Die Funktion testet ohne zu blockieren, ob alle übergebenen Requests abgeschlossen sind. NULL-Einträge und nie
+ * gestartete Requests werden übergangen.
+ *
+ * @param [in]  count Anzahl der Requests
+ * @param [in]  requests Feld mit count Requests
+ * @param [out] flag OSMP_DONE, wenn alle Requests abgeschlossen sind, sonst OSMP_WAITING
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Testall(int count, OSMP_Request *requests, int *flag);
+
+/**
+ * Die Funktion liefert ohne zu blockieren die Indizes aller übergebenen Requests, die seit ihrem Start abgeschlossen
+ * und noch nicht von OSMP_Waitany() oder OSMP_Testsome() gemeldet wurden, in der Reihenfolge ihrer Fertigstellung.
+ *
+ * @param [in]  count Anzahl der Requests
+ * @param [in]  requests Feld mit count Requests
+ * @param [out] outcount Anzahl der gelieferten Indizes oder OSMP_UNDEFINED, wenn keine Request mehr aussteht
+ * @param [out] indices Feld mit mindestens count Einträgen für die Indizes
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_Testsome(int count, OSMP_Request *requests, int *outcount, int *indices);
+
+/**
+ * Die Funktion liefert einen nicht blockierenden Eventfd-Dateideskriptor, der sich z.B. mit poll() oder epoll
+ * überwachen lässt. Er wird lesbar, sobald eine Nachricht für den aufrufenden Prozess eintrifft oder eine seiner
+ * Requests abgeschlossen wird. Liegen beim Aufruf bereits Nachrichten vor, ist er sofort lesbar.
+ *
+ * Nach dem Aufwachen liest der Aufrufer den Zähler mit read() zurück und verarbeitet anschließend alle vorliegenden
+ * Nachrichten (z.B. mit OSMP_Iprobe()) und Requests (z.B. mit OSMP_Testsome()). Der Deskriptor kann auch lesbar sein,
+ * wenn die Nachricht inzwischen von einem anderen Aufruf empfangen wurde. Er gehört der Bibliothek und darf nicht
+ * geschlossen werden; OSMP_Finalize() schließt ihn. Der erste Aufruf legt ihn an (mit FD_CLOEXEC) und startet einen
+ * Hilfsthread, der ihn signalisiert; wiederholte Aufrufe liefern denselben Deskriptor.
+ *
+ * @param [out] fd Der Dateideskriptor
+ *
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int OSMP_GetEventFd(int *fd);
+
 /**
  * Gibt den Namen des Shared Memory Bereichs zurück.
  *
@@ -0,0 +1,183 @@
+/**
+ * In dieser Quelltext-Datei ist die Warte-Primitive der OSMP Bibliothek implementiert.
+ */
+#define _GNU_SOURCE
+
+#include "osmp_sync.h"
+#include "OSMP.h"
+#include <limits.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/**
+ * Obergrenze für die aktiven Warterunden; wird in OSMP_Init() aus dem Shared Memory übernommen.
+ */
+int spin_budget = OSMP_DEFAULT_SPIN_BUDGET;
+
+/**
+ * Geschätzte Anzahl aktiver Warterunden für osmp_wait_while_equal().
+ */
+int wait_spin = 0;
+
+/**
+ * Signalisiert dem Prozessor, dass der aufrufende Thread aktiv wartet.
+ */
+void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * Legt den aufrufenden Thread schlafen, solange *word den Wert value hat.
+ * @param word    Zeiger auf das Futex-Wort.
+ * @param value   Erwarteter Wert.
+ * @param private 1, wenn das Wort nur im aufrufenden Prozess verwendet wird.
+ */
+void futex_wait(int* word, int value, int private) {
+    // Ohne FUTEX_PRIVATE_FLAG, wenn das Wort im Shared Memory liegen kann
+    syscall(SYS_futex, word, private ? FUTEX_WAIT_PRIVATE : FUTEX_WAIT, value, NULL, NULL, 0);
+}
+
+/**
+ * Weckt bis zu count Threads, die auf word schlafen.
+ * @param word    Zeiger auf das Futex-Wort.
+ * @param count   Höchstzahl zu weckender Threads.
+ * @param private 1, wenn das Wort nur im aufrufenden Prozess verwendet wird.
+ */
+void futex_wake(int* word, int count, int private) {
+    syscall(SYS_futex, word, private ? FUTEX_WAKE_PRIVATE : FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+/**
+ * Passt eine Schätzung der nötigen Warterunden an das Ergebnis des letzten Wartens an.
+ * @param estimate Zeiger auf die Schätzung.
+ * @param rounds   Tatsächlich gewartete Runden.
+ */
+void update_spin_estimate(int* estimate, int rounds) {
+    int current = __atomic_load_n(estimate, __ATOMIC_RELAXED);
+    __atomic_store_n(estimate, current + (rounds - current) / 8, __ATOMIC_RELAXED);
+}
+
+/**
+ * Berechnet die Anzahl aktiver Warterunden aus einer Schätzung, begrenzt durch das Spin-Budget.
+ * @param estimate Zeiger auf die Schätzung.
+ * @return Anzahl der Runden, die aktiv gewartet werden soll.
+ */
+int get_spin_limit(int* estimate) {
+    int limit = __atomic_load_n(estimate, __ATOMIC_RELAXED) * 2 + 10;
+    return limit < spin_budget ? limit : spin_budget;
+}
+
+void osmp_sync_set_spin_budget(int budget) {
+    spin_budget = budget < 0 ? 0 : budget;
+}
+
+void osmp_sem_init(osmp_sem* sem, int value) {
+    sem->value = value;
+    sem->waiters = 0;
+    sem->spin = 0;
+}
+
+int osmp_sem_trywait(osmp_sem* sem) {
+    int value = __atomic_load_n(&sem->value, __ATOMIC_RELAXED);
+    while(value > 0) {
+        if(__atomic_compare_exchange_n(&sem->value, &value, value - 1, 1, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return OSMP_SUCCESS;
+        }
+    }
+    return OSMP_FAILURE;
+}
+
+void osmp_sem_wait(osmp_sem* sem) {
+    // Aktive Phase: der Partner ist oft nur wenige Mikrosekunden entfernt
+    int limit = get_spin_limit(&sem->spin);
+    for(int rounds = 0; rounds < limit; rounds++) {
+        if(osmp_sem_trywait(sem) == OSMP_SUCCESS) {
+            update_spin_estimate(&sem->spin, rounds);
+            return;
+        }
+        cpu_relax();
+    }
+    // Aktives Warten hat nicht gereicht; beim nächsten Mal früher schlafen legen
+    update_spin_estimate(&sem->spin, 0);
+
+    // Schlafphase: waiters wird vor dem Prüfen von value erhöht, damit osmp_sem_post() kein Wecken verpasst
+    __atomic_fetch_add(&sem->waiters, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    while(osmp_sem_trywait(sem) != OSMP_SUCCESS) {
+        futex_wait(&sem->value, 0, 0);
+    }
+    __atomic_fetch_sub(&sem->waiters, 1, __ATOMIC_RELAXED);
+}
+
+void osmp_sem_post(osmp_sem* sem) {
+    __atomic_fetch_add(&sem->value, 1, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&sem->waiters, __ATOMIC_SEQ_CST) > 0) {
+        futex_wake(&sem->value, 1, 0);
+    }
+}
+
+int osmp_sem_trywait_many(osmp_sem* sem, int max) {
+    int value = __atomic_load_n(&sem->value, __ATOMIC_RELAXED);
+    while(value > 0 && max > 0) {
+        int taken = value < max ? value : max;
+        if(__atomic_compare_exchange_n(&sem->value, &value, value - taken, 1, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return taken;
+        }
+    }
+    return 0;
+}
+
+int osmp_sem_wait_many(osmp_sem* sem, int max) {
+    osmp_sem_wait(sem);
+    return 1 + osmp_sem_trywait_many(sem, max - 1);
+}
+
+void osmp_sem_post_many(osmp_sem* sem, int count) {
+    __atomic_fetch_add(&sem->value, count, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&sem->waiters, __ATOMIC_SEQ_CST) > 0) {
+        futex_wake(&sem->value, count, 0);
+    }
+}
+
+/**
+ * Blockiert, solange *word den Wert value hat: erst aktiv, dann per Futex.
+ * @param word    Zeiger auf das Futex-Wort.
+ * @param value   Wert, bei dem gewartet wird.
+ * @param private 1, wenn das Wort nur im aufrufenden Prozess verwendet wird.
+ */
+void wait_while_equal(int* word, int value, int private) {
+    int limit = get_spin_limit(&wait_spin);
+    for(int rounds = 0; rounds < limit; rounds++) {
+        if(__atomic_load_n(word, __ATOMIC_ACQUIRE) != value) {
+            update_spin_estimate(&wait_spin, rounds);
+            return;
+        }
+        cpu_relax();
+    }
+    update_spin_estimate(&wait_spin, 0);
+
+    while(__atomic_load_n(word, __ATOMIC_ACQUIRE) == value) {
+        futex_wait(word, value, private);
+    }
+}
+
+void osmp_wait_while_equal(int* word, int value) {
+    wait_while_equal(word, value, 0);
+}
+
+void osmp_wake_all(int* word) {
+    futex_wake(word, INT_MAX, 0);
+}
+
+void osmp_wait_while_equal_private(int* word, int value) {
+    wait_while_equal(word, value, 1);
+}
+
+void osmp_wake_all_private(int* word) {
+    futex_wake(word, INT_MAX, 1);
+}
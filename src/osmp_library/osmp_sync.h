@@ -0,0 +1,123 @@
+#ifndef BETRIEBSSYSTEME_OSMP_SYNC_H
+#define BETRIEBSSYSTEME_OSMP_SYNC_H
+
+/**
+ * In dieser Header-Datei ist die Warte-Primitive der OSMP Bibliothek deklariert. Alle blockierenden Stellen der
+ * Bibliothek warten zunächst eine begrenzte, adaptiv angepasste Anzahl von Runden aktiv und legen sich erst danach per
+ * Futex schlafen. Alle Strukturen funktionieren prozessübergreifend im Shared Memory und benötigen keine Freigabe.
+ */
+
+/**
+ * Standardwert für die maximale Anzahl aktiver Warterunden, bevor ein Prozess per Futex schlafen gelegt wird.
+ */
+#define OSMP_DEFAULT_SPIN_BUDGET 1000
+
+/**
+ * @struct osmp_sem
+ * @brief Zählende Semaphore auf Basis eines Futex.
+ */
+typedef struct osmp_sem {
+    /**
+     * @var value
+     * Aktueller Wert der Semaphore; dient zugleich als Futex-Wort.
+     */
+    int value;
+
+    /**
+     * @var waiters
+     * Anzahl der schlafenden oder einschlafenden Prozesse. Nur wenn sie größer als 0 ist, weckt osmp_sem_post().
+     */
+    int waiters;
+
+    /**
+     * @var spin
+     * Geschätzte Anzahl aktiver Warterunden, nach denen die Semaphore zuletzt frei wurde.
+     */
+    int spin;
+} osmp_sem;
+
+/**
+ * Setzt die maximale Anzahl aktiver Warterunden für den aufrufenden Prozess.
+ * @param spin_budget Maximale Anzahl aktiver Warterunden; 0 deaktiviert das aktive Warten.
+ */
+void osmp_sync_set_spin_budget(int spin_budget);
+
+/**
+ * Initialisiert eine Semaphore.
+ * @param sem   Zeiger auf die Semaphore.
+ * @param value Startwert der Semaphore.
+ */
+void osmp_sem_init(osmp_sem* sem, int value);
+
+/**
+ * Verringert den Wert der Semaphore um 1. Blockiert, solange der Wert 0 ist.
+ * @param sem Zeiger auf die Semaphore.
+ */
+void osmp_sem_wait(osmp_sem* sem);
+
+/**
+ * Verringert den Wert der Semaphore um 1, ohne zu blockieren.
+ * @param sem Zeiger auf die Semaphore.
+ * @return OSMP_SUCCESS, wenn der Wert verringert wurde, sonst OSMP_FAILURE.
+ */
+int osmp_sem_trywait(osmp_sem* sem);
+
+/**
+ * Erhöht den Wert der Semaphore um 1 und weckt gegebenenfalls einen wartenden Prozess.
+ * @param sem Zeiger auf die Semaphore.
+ */
+void osmp_sem_post(osmp_sem* sem);
+
+/**
+ * Verringert den Wert der Semaphore um bis zu max, ohne zu blockieren.
+ * @param sem Zeiger auf die Semaphore.
+ * @param max Höchstzahl der zu entnehmenden Einheiten.
+ * @return Anzahl der entnommenen Einheiten (0 bis max).
+ */
+int osmp_sem_trywait_many(osmp_sem* sem, int max);
+
+/**
+ * Verringert den Wert der Semaphore um bis zu max. Blockiert nur, bis mindestens eine Einheit verfügbar ist.
+ * @param sem Zeiger auf die Semaphore.
+ * @param max Höchstzahl der zu entnehmenden Einheiten (mindestens 1).
+ * @return Anzahl der entnommenen Einheiten (1 bis max).
+ */
+int osmp_sem_wait_many(osmp_sem* sem, int max);
+
+/**
+ * Erhöht den Wert der Semaphore um count und weckt mit einem einzigen Aufruf bis zu count wartende Prozesse.
+ * @param sem   Zeiger auf die Semaphore.
+ * @param count Anzahl der freigegebenen Einheiten.
+ */
+void osmp_sem_post_many(osmp_sem* sem, int count);
+
+/**
+ * Blockiert, solange *word den Wert value hat.
+ * @param word  Zeiger auf das Futex-Wort.
+ * @param value Wert, bei dem gewartet wird.
+ */
+void osmp_wait_while_equal(int* word, int value);
+
+/**
+ * Weckt alle Prozesse und Threads, die mit osmp_wait_while_equal() auf word warten. Das Wort muss vorher geändert
+ * worden sein.
+ * @param word Zeiger auf das Futex-Wort.
+ */
+void osmp_wake_all(int* word);
+
+/**
+ * Wie osmp_wait_while_equal(), für Wörter, die nur innerhalb des aufrufenden Prozesses verwendet werden. Der Kernel
+ * muss das Wort dann nicht über die Seitentabellen einem gemeinsamen Objekt zuordnen.
+ * @param word  Zeiger auf das Futex-Wort im privaten Speicher des Prozesses.
+ * @param value Wert, bei dem gewartet wird.
+ */
+void osmp_wait_while_equal_private(int* word, int value);
+
+/**
+ * Weckt alle Threads des aufrufenden Prozesses, die mit osmp_wait_while_equal_private() auf word warten. Das Wort
+ * muss vorher geändert worden sein.
+ * @param word Zeiger auf das Futex-Wort im privaten Speicher des Prozesses.
+ */
+void osmp_wake_all_private(int* word);
+
+#endif //BETRIEBSSYSTEME_OSMP_SYNC_H
@@ -6,6 +6,7 @@
 
 #include "osmplib.h"
 #include "logger.h"
+#include "osmp_sync.h"
 #include "OSMP.h"
 #include <string.h>
 #include <unistd.h>
@@ -14,12 +15,59 @@
 #include <fcntl.h>
 #include <malloc.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <sched.h>
+#include <sys/uio.h>
+#include <sys/prctl.h>
+#include <sys/eventfd.h>
+#include <errno.h>
 
 shared_memory *shm_ptr = NULL;
+memory_offsets offsets;
 int shared_memory_fd, OSMP_size, OSMP_rank = OSMP_FAILURE, memory_size;
-thread_node * erster_thread = NULL;
-thread_node * letzter_thread = NULL;
-pthread_mutex_t * thread_linked_list_mutex = NULL;
+progress_queue * progress_queues = NULL;
+progress_queue * progress_ready_first = NULL;
+progress_queue * progress_ready_last = NULL;
+int progress_ready_count = 0;
+pthread_t progress_threads[PROGRESS_THREADS];
+int progress_thread_count = 0;
+int progress_idle = 0;
+int progress_blocking = 0;
+int progress_stopping = 0;
+pthread_mutex_t progress_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t progress_condition = PTHREAD_COND_INITIALIZER;
+// Zahl der Fertigstellungen von Requests; Futex-Wort, auf dem OSMP_Waitany() und OSMP_Waitall() schlafen
+int completion_count = 0;
+uint64_t completion_stamps = 0;
+int completion_waiters = 0;
+// Kleinster Stand von completion_count, bei dem ein Wartender geweckt werden will
+int completion_wake_at = COMPLETION_NO_TARGET;
+// Request-Pool: Blöcke von Requests, die freien über next verkettet
+IParams * request_blocks[REQUEST_BLOCKS];
+int request_block_count = 0;
+IParams * request_free = NULL;
+pthread_mutex_t request_mutex = PTHREAD_MUTEX_INITIALIZER;
+borrowed_buffer * borrowed_buffers = NULL;
+pthread_mutex_t borrowed_buffers_mutex = PTHREAD_MUTEX_INITIALIZER;
+int rendezvous_disabled = 0;
+int direct_disabled = 0;
+int huge_page_segment = 0;
+pending_message * pending_nodes = NULL;
+pending_message ** pending_first = NULL;
+pending_message ** pending_last = NULL;
+pending_message * arrival_first = NULL;
+pending_message * arrival_last = NULL;
+int pending_draining = 0;
+pthread_mutex_t pending_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t pending_condition = PTHREAD_COND_INITIALIZER;
+inline_message ** inline_blocks = NULL;
+int inline_block_count = 0;
+int inline_free = NO_MESSAGE;
+int inline_spare = 0;
+pthread_mutex_t inline_mutex = PTHREAD_MUTEX_INITIALIZER;
+int event_fd = -1;
+pthread_t event_thread;
+pthread_mutex_t event_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 /**
  * Übergibt eine Level-1-Lognachricht an den Logger.
@@ -51,375 +99,2171 @@ process_info* get_process_info(int rank) {
 }
 
 /**
- * Gibt den Index des Nachrichtenslots zurück, in dem die nächste Nachricht für den aufrufenden Prozess liegt.
- * @return Index des Slots, in dem die nächste Nachricht für den aufrufenden Prozess liegt.
+ * Liefert den Kopf eines Nachrichtenslots.
+ * @param slot_index Index des Nachrichtenslots.
+ * @return Zeiger auf den Kopf des Nachrichtenslots im Shared Memory.
  */
-int get_next_message(void ) {
-    log_osmp_lib_call("get_next_message");
-    process_info* process = get_process_info(OSMP_rank);
+message_slot* get_slot(int slot_index) {
+    return (message_slot*)((char*)shm_ptr + offsets.slots) + slot_index;
+}
 
-    sem_wait(&process->postbox.sem_proc_full);
+/**
+ * Liefert die Verkettung der freien Nachrichtenslots.
+ * @return Zeiger auf das int-Array der Verkettung.
+ */
+int* get_next_free_slots(void) {
+    return (int*)((char*)shm_ptr + offsets.next_free_slot);
+}
 
-    pthread_mutex_lock(&process->postbox.mutex_proc_out);
+/**
+ * Liefert den Eintrag im Ringpuffer eines Postfachs, der zu einer Schreib- oder Leseposition gehört.
+ * @param rank     Rang des Prozesses, dem das Postfach gehört.
+ * @param position Monoton steigende Position im Ringpuffer.
+ * @return Zeiger auf den Eintrag im Shared Memory.
+ */
+postbox_entry* get_postbox_entry(int rank, uint64_t position) {
+    size_t depth = (size_t)shm_ptr->max_messages_proc;
+    char* postbox = (char*)shm_ptr + offsets.postbox_entries + (size_t)rank * offsets.postbox_stride;
+    postbox_entry* first = (postbox_entry*)postbox;
+    return first + position % depth;
+}
 
-    pthread_mutex_lock(&(process->postbox.sem_proc_full_value_mutex));
-    process->postbox.sem_proc_full_value--;
-    pthread_mutex_unlock(&(process->postbox.sem_proc_full_value_mutex));
+/**
+ * Liefert die Länge der Teilstücke, in denen Nachrichten oberhalb der maximalen Nutzlast übertragen werden. Die
+ * Teilstücke liegen als Ringpuffer im Heap-Block des Nachrichtenslots.
+ * @return Länge eines Teilstücks in Bytes.
+ */
+int get_chunk_length(void) {
+    return shm_ptr->max_payload_length / CHUNK_DEPTH;
+}
 
+/**
+ * Entnimmt lock-frei das oberste Element eines Stapels mit Versionszähler.
+ * @param head Kopf des Stapels (Versionszähler und Index).
+ * @param next Verkettung der Elemente (Index des jeweils darunterliegenden Elements).
+ * @return Index des entnommenen Elements oder NO_SLOT, wenn der Stapel leer ist.
+ */
+int tagged_stack_pop(uint64_t* head, int* next) {
+    uint64_t old_head = __atomic_load_n(head, __ATOMIC_ACQUIRE);
+    uint64_t new_head;
+    int index;
+    do {
+        index = TAGGED_HEAD_INDEX(old_head);
+        if(index == NO_SLOT) {
+            return NO_SLOT;
+        }
+        // Ein veralteter Wert wird durch den Versionszähler beim Compare-and-Swap erkannt
+        int following = __atomic_load_n(&next[index], __ATOMIC_RELAXED);
+        new_head = TAGGED_HEAD(TAGGED_HEAD_TAG(old_head) + 1, following);
+    } while(!__atomic_compare_exchange_n(head, &old_head, new_head, 1, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+    return index;
+}
 
-    int out_index = process->postbox.out_index;
-    int slot_index = process->postbox.postbox[out_index];
-    process->postbox.postbox[out_index] = NO_MESSAGE;
-    (process->postbox.out_index)++;
-    if(process->postbox.out_index==OSMP_MAX_MESSAGES_PROC){
-        process->postbox.out_index= 0;
-    }
+/**
+ * Legt ein Element lock-frei auf einen Stapel mit Versionszähler.
+ * @param head  Kopf des Stapels (Versionszähler und Index).
+ * @param next  Verkettung der Elemente (Index des jeweils darunterliegenden Elements).
+ * @param index Index des Elements, das abgelegt wird.
+ */
+void tagged_stack_push(uint64_t* head, int* next, int index) {
+    uint64_t old_head = __atomic_load_n(head, __ATOMIC_RELAXED);
+    uint64_t new_head;
+    do {
+        __atomic_store_n(&next[index], TAGGED_HEAD_INDEX(old_head), __ATOMIC_RELAXED);
+        new_head = TAGGED_HEAD(TAGGED_HEAD_TAG(old_head) + 1, index);
+    } while(!__atomic_compare_exchange_n(head, &old_head, new_head, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
 
-    pthread_mutex_unlock(&process->postbox.mutex_proc_out);
+/**
+ * Entnimmt lock-frei die obersten count Elemente eines Stapels mit Versionszähler in einem einzigen Compare-and-Swap.
+ * Der Aufrufer muss sichergestellt haben, dass der Stapel mindestens count Elemente enthält.
+ * @param head    Kopf des Stapels (Versionszähler und Index).
+ * @param next    Verkettung der Elemente (Index des jeweils darunterliegenden Elements).
+ * @param count   Anzahl der zu entnehmenden Elemente.
+ * @param indices Feld für die Indizes der entnommenen Elemente (mindestens count Einträge).
+ */
+void tagged_stack_pop_many(uint64_t* head, int* next, int count, int* indices) {
+    uint64_t old_head = __atomic_load_n(head, __ATOMIC_ACQUIRE);
+    uint64_t new_head;
+    int complete;
+    do {
+        // Ein veralteter Wert kann die Kette vorzeitig beenden; der Compare-and-Swap schlägt dann ohnehin fehl
+        int index = TAGGED_HEAD_INDEX(old_head);
+        complete = 1;
+        for(int i = 0; i < count; i++) {
+            if(index == NO_SLOT) {
+                complete = 0;
+                break;
+            }
+            indices[i] = index;
+            index = __atomic_load_n(&next[index], __ATOMIC_RELAXED);
+        }
+        new_head = TAGGED_HEAD(TAGGED_HEAD_TAG(old_head) + 1, index);
+        if(!complete) {
+            old_head = __atomic_load_n(head, __ATOMIC_ACQUIRE);
+        }
+    } while(!complete ||
+            !__atomic_compare_exchange_n(head, &old_head, new_head, 1, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+}
 
-    sem_post(&process->postbox.sem_proc_empty);
+/**
+ * Legt mehrere Elemente lock-frei mit einem einzigen Compare-and-Swap auf einen Stapel mit Versionszähler. Das erste
+ * Element liegt danach oben.
+ * @param head    Kopf des Stapels (Versionszähler und Index).
+ * @param next    Verkettung der Elemente (Index des jeweils darunterliegenden Elements).
+ * @param indices Indizes der abzulegenden Elemente.
+ * @param count   Anzahl der Elemente (mindestens 1).
+ */
+void tagged_stack_push_many(uint64_t* head, int* next, const int* indices, int count) {
+    // Die Elemente gehören bis zum Compare-and-Swap nur dem Aufrufer und können vorher verkettet werden
+    for(int i = 0; i < count - 1; i++) {
+        __atomic_store_n(&next[indices[i]], indices[i + 1], __ATOMIC_RELAXED);
+    }
+    uint64_t old_head = __atomic_load_n(head, __ATOMIC_RELAXED);
+    uint64_t new_head;
+    do {
+        __atomic_store_n(&next[indices[count - 1]], TAGGED_HEAD_INDEX(old_head), __ATOMIC_RELAXED);
+        new_head = TAGGED_HEAD(TAGGED_HEAD_TAG(old_head) + 1, indices[0]);
+    } while(!__atomic_compare_exchange_n(head, &old_head, new_head, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
 
-    return slot_index;
+/**
+ * Rundet einen Offset im Shared Memory auf den Beginn der nächsten Cache-Line auf.
+ * @param offset Offset in Bytes.
+ * @return Aufgerundeter Offset in Bytes.
+ */
+size_t align_to_cache_line(size_t offset) {
+    return (offset + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
 }
 
 /**
- * Die Funktion create_thread() fügt ein neues Thread in die liste der Threads und speichert den in thread.
- * @param thread Der gestarte Thread.
- * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ * Berechnet die Lage der Größenklassen des Heaps im Shared Memory. Die letzte genutzte Klasse ist die erste, deren
+ * Blockgröße die maximale Nutzlast erreicht; ihre Blöcke sind genau so groß wie die maximale Nutzlast.
+ * @param classes        Array mit HEAP_CLASSES Einträgen, in das Blockgrößen, Blockanzahlen und Offsets geschrieben
+ *                       werden. Darf NULL sein, wenn nur die Größe benötigt wird.
+ * @param class_count    Anzahl der genutzten Größenklassen. Darf NULL sein.
+ * @param offset         Offset (ab Beginn des Shared Memory), an dem der Heap beginnt.
+ * @param processes      Anzahl der Prozesse.
+ * @param slots          Anzahl der Nachrichtenslots.
+ * @param payload_length Maximale Nutzlast eines Nachrichtenslots in Bytes.
+ * @return Offset des ersten Bytes hinter dem Heap.
  */
-int create_thread(pthread_t** thread) {
-    log_osmp_lib_call("create_thread");
+size_t heap_layout(heap_class* classes, int* class_count, size_t offset, int processes, int slots,
+                   int payload_length) {
+    int sizes[HEAP_CLASSES] = HEAP_CLASS_SIZES;
+    int counts[HEAP_CLASSES] = HEAP_CLASS_COUNTS;
+
+    int used = 0;
+    while(used < HEAP_CLASSES) {
+        int i = used++;
+        int size = (i == HEAP_CLASSES - 1 || sizes[i] >= payload_length) ? payload_length : sizes[i];
+        int blocks = counts[i] == 0 ? slots : counts[i];
+        if(blocks < processes) {
+            blocks = processes;
+        }
+        // Wie bei den Nachrichtenslots wird ein Teil der Blöcke gleichmäßig für die Sender reserviert
+        int reserved = blocks / (SLOT_RESERVE_SHARE * processes);
+        size_t count = (size_t)blocks;
+        offset = align_to_cache_line(offset);
+        if(classes != NULL) {
+            classes[i].block_size = size;
+            classes[i].block_count = blocks;
+            classes[i].reserved_blocks = reserved > 0 ? reserved : 1;
+            classes[i].next_offset = offset;
+            classes[i].owner_offset = offset + count * sizeof(int);
+        }
+        offset += 2 * count * sizeof(int);
 
-    pthread_mutex_lock(thread_linked_list_mutex);
-    thread_node * node = malloc(sizeof(thread_node));
-    if(node == NULL){
-        log_to_file(3, "Failed to allocate memory for a thread.\n");
-        return OSMP_FAILURE;
+        offset = align_to_cache_line(offset);
+        if(classes != NULL) {
+            classes[i].blocks_offset = offset;
+        }
+        offset += count * (size_t)size;
+        if(size == payload_length) {
+            break;
+        }
     }
-    node->next = NULL;
-    node->prev = NULL;
-    if (erster_thread == NULL){
-        erster_thread = node;
-        letzter_thread = node;
-    } else{
-        node->prev = letzter_thread;
-        letzter_thread->next = node;
-        letzter_thread = node;
+    if(class_count != NULL) {
+        *class_count = used;
     }
-    *thread = &(node->thread);
-    pthread_mutex_unlock(thread_linked_list_mutex);
-    return OSMP_SUCCESS;
+    return offset;
 }
 
 /**
- * Wartet bis alle gestartete Threads fertig sind und beendet die.
+ * Liefert die Verkettung der freien Blöcke einer Größenklasse.
+ * @param heap_class_index Index der Größenklasse.
+ * @return Zeiger auf das int-Array der Verkettung.
  */
-void wait_and_finalize_all_threads(void){
-    log_osmp_lib_call("wait_and_finalize_all_threads");
-    thread_node * iterator = erster_thread;
-    while (iterator!=NULL){
-        thread_node * temp = iterator;
-        iterator = iterator->next;
-        pthread_join(temp->thread, NULL);
-        temp->next = NULL;
-        temp->prev = NULL;
-        free(temp);
-    }
-    erster_thread = NULL;
-    letzter_thread = NULL;
+int* get_heap_next(int heap_class_index) {
+    return (int*)((char*)shm_ptr + shm_ptr->heap[heap_class_index].next_offset);
 }
 
-
 /**
- * Setzt die globalen Variablen der OSMP-Bibliothek für den Elternprozess.
- * @param fd    Shared-Memory-File-Descriptor.
- * @param shm   Zeiger auf den Beginn des Shared Memory.
- * @param size  Größe des Shared Memory in Bytes.
+ * Liefert die Zuordnung der Blöcke einer Größenklasse zu ihren Nachrichtenslots und Zuständen (siehe BLOCK_OWNER).
+ * @param heap_class_index Index der Größenklasse.
+ * @return Zeiger auf das int-Array der Zuordnung.
  */
-void OSMP_Init_Runner(int fd, shared_memory* shm, int size) {
-    shared_memory_fd = fd;
-    memory_size = size;
-    shm_ptr = shm;
-    OSMP_Size(&OSMP_size);
+int* get_heap_owner(int heap_class_index) {
+    return (int*)((char*)shm_ptr + shm_ptr->heap[heap_class_index].owner_offset);
 }
 
 /**
- * Berechnet den für den Shared Memory benötigten Speicherplatz in Abhängigkeit von der Anzahl der Prozesse.
- * @param processes Die Anzahl der Executable-Prozesse, die verwaltet werden.
- * @return Die Größe des benötigten Speicherplatzes in Bytes.
+ * Liefert einen Zeiger auf den Anfang eines Heap-Blocks.
+ * @param heap_class_index Index der Größenklasse.
+ * @param block            Index des Blocks innerhalb der Größenklasse.
+ * @return Zeiger auf den Block im Shared Memory.
  */
-int calculate_shared_memory_size(int processes) {
-    int size = (int)sizeof(shared_memory);
-    // Das Struct enthält bereits Speicher für einen Prozess; nur der nötige Speicher für die weiteren n-1 Prozesse muss
-    // noch addiert werden.
-    size += (processes-1) * (int)sizeof(process_info);
-    return size;
+char* get_heap_block(int heap_class_index, int block) {
+    heap_class* heap = &(shm_ptr->heap[heap_class_index]);
+    return (char*)shm_ptr + heap->blocks_offset + (size_t)block * (size_t)heap->block_size;
 }
 
 /**
- * Interne Implementierung der OSMP_Barrier()-Funktion. Der Hauptteil wird mithilfe der Posix-Funktion
- * pthread_cond_wait() implementiert, die eine Voraussetzung (Prediction) und eine Bedingung (Condition) benötigt.
- * @param barrier Zeiger auf die Barriere, an der gewartet werden soll.
- * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE.
+ * Ermittelt die kleinste Größenklasse, deren Blöcke eine Nachricht der angegebenen Länge aufnehmen können.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @return Index der Größenklasse oder NO_SLOT, wenn die Nachricht für alle Klassen zu groß ist.
  */
-int barrier_wait(barrier_t* barrier) {
-    log_osmp_lib_call("barrier_wait");
-    int status, cancel, tmp, cycle;
-    // Thread-Safety:
-    if(getpid()!=gettid()) {
-        log_to_file(3, "Thread calling barrier.");
-        return OSMP_FAILURE;
+int get_heap_class(int length_in_bytes) {
+    for(int i=0; i<shm_ptr->heap_classes; i++) {
+        if(length_in_bytes <= shm_ptr->heap[i].block_size) {
+            return i;
+        }
     }
+    return NO_SLOT;
+}
 
-    if(barrier->valid != BARRIER_VALID) {
-        log_to_file(3, "Barrier not yet initialized, can't wait at barrier!");
-        return OSMP_FAILURE;
+/**
+ * Liefert die Semaphore, an die die Berechtigung für einen Heap-Block zurückgegeben wird.
+ * @param heap_class_index Index der Größenklasse.
+ * @param block_owner      Rang des Senders, aus dessen Reservierung der Block stammt, oder SHARED_CREDIT.
+ * @return Zeiger auf die Semaphore der Reservierung oder des gemeinsamen Vorrats.
+ */
+osmp_sem* get_heap_credit_semaphore(int heap_class_index, int block_owner) {
+    if(block_owner == SHARED_CREDIT) {
+        return &shm_ptr->heap[heap_class_index].sem_free_blocks;
     }
+    return &get_process_info(block_owner)->sem_heap_credits[heap_class_index];
+}
 
-    status = pthread_mutex_lock(&(barrier->mutex));
-    if(status != 0) {
-        log_to_file(3, "Failed to lock barrier mutex!");
-        return OSMP_FAILURE;
+/**
+ * Reserviert einen Block der angegebenen Größenklasse, zuerst aus der Reservierung des aufrufenden Prozesses und dann
+ * aus dem gemeinsamen Vorrat. Sind beide erschöpft, wird auf die Rückgabe eines reservierten Blocks gewartet, sodass
+ * andere Sender den Aufrufer nicht aushungern können.
+ * @param heap_class_index Index der Größenklasse.
+ * @param block_owner      Ausgabe: Herkunft der Berechtigung (siehe message_slot.block_owner).
+ * @return Index des reservierten Blocks.
+ */
+int heap_alloc(int heap_class_index, int* block_owner) {
+    log_osmp_lib_call("heap_alloc");
+    heap_class* heap = &(shm_ptr->heap[heap_class_index]);
+    osmp_sem* own = &get_process_info(OSMP_rank)->sem_heap_credits[heap_class_index];
+    if(osmp_sem_trywait(own) == OSMP_SUCCESS) {
+        *block_owner = OSMP_rank;
+    } else if(osmp_sem_trywait(&heap->sem_free_blocks) == OSMP_SUCCESS) {
+        *block_owner = SHARED_CREDIT;
+    } else {
+        osmp_sem_wait(own);
+        *block_owner = OSMP_rank;
     }
+    // Die Berechtigung garantiert, dass der Stapel einen freien Block enthält
+    return tagged_stack_pop(&heap->free_blocks, get_heap_next(heap_class_index));
+}
 
-    cycle = barrier->cycle; // aktuellen Zyklus merken
-
-    (barrier->counter)--;
-
-    if(barrier->counter== 0) {
-        // Der letzte Thread in der Barriere initialisiert die Barrier für den nächsten Durchlauf.
-        barrier->counter = OSMP_size;
-        (barrier->cycle)++;
-        pthread_cond_broadcast(&(barrier->convar));
+/**
+ * Reserviert wie heap_alloc() einen Block der angegebenen Größenklasse, ohne zu blockieren.
+ * @param heap_class_index Index der Größenklasse.
+ * @param block_owner      Ausgabe: Herkunft der Berechtigung (siehe message_slot.block_owner).
+ * @return Index des reservierten Blocks oder NO_SLOT, wenn weder die Reservierung noch der gemeinsame Vorrat einen
+ *         Block enthält.
+ */
+int heap_try_alloc(int heap_class_index, int* block_owner) {
+    log_osmp_lib_call("heap_try_alloc");
+    heap_class* heap = &(shm_ptr->heap[heap_class_index]);
+    if(osmp_sem_trywait(&get_process_info(OSMP_rank)->sem_heap_credits[heap_class_index]) == OSMP_SUCCESS) {
+        *block_owner = OSMP_rank;
+    } else if(osmp_sem_trywait(&heap->sem_free_blocks) == OSMP_SUCCESS) {
+        *block_owner = SHARED_CREDIT;
     } else {
-        // Da barrier_wait() kein Abbruchpunkt sein sollte, wird Abbruch deaktiviert.
-        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &cancel);
-
-        /* Warten, bis sich die Zyklusnummer der Voraussetzung (Prediction) ändert, was bedeutet, dass nicht länger
-         * gewartet werden soll und die Bedingung (Condition) erfüllt ist. */
-        while(cycle == barrier->cycle) {
-            status = pthread_cond_wait(&(barrier->convar), &(barrier->mutex));
-            if(status != 0) {
-                break;
-            }
-        }
-
-        pthread_setcancelstate(cancel, &tmp);
+        return NO_SLOT;
     }
+    return tagged_stack_pop(&heap->free_blocks, get_heap_next(heap_class_index));
+}
 
-    status = pthread_mutex_unlock(&(barrier->mutex));
-    if(status != 0) {
-        log_to_file(3, "Failed to unlock barrier mutex!");
-        return OSMP_FAILURE;
-    }
-    return OSMP_SUCCESS;
+/**
+ * Gibt einen Block an seine Größenklasse und seine Berechtigung an ihre Herkunft zurück.
+ * @param heap_class_index Index der Größenklasse.
+ * @param block            Index des Blocks innerhalb der Größenklasse.
+ * @param block_owner      Herkunft der Berechtigung, wie sie heap_alloc() geliefert hat.
+ */
+void heap_free(int heap_class_index, int block, int block_owner) {
+    log_osmp_lib_call("heap_free");
+    heap_class* heap = &(shm_ptr->heap[heap_class_index]);
+    tagged_stack_push(&heap->free_blocks, get_heap_next(heap_class_index), block);
+    osmp_sem_post(get_heap_credit_semaphore(heap_class_index, block_owner));
 }
 
-int OSMP_Init(const int *argc, char ***argv) {
-    if(gettid() != getpid()){
-        printf("Initializing of threads is not allowed\n");
-        exit(0);
-    }
-    char *shared_memory_name;
-    OSMP_GetSharedMemoryName(&shared_memory_name);
-    shared_memory_fd = shm_open(shared_memory_name,O_RDWR, 0666);
-    if(shared_memory_fd == -1){
-        printf("Failed to open shared memory.\n");
-        return OSMP_FAILURE;
+/**
+ * Ermittelt den Heap-Block, auf dessen Anfang ein Zeiger zeigt.
+ * @param ptr              Zeiger in den Shared Memory.
+ * @param heap_class_index Ausgabe: Index der Größenklasse des Blocks.
+ * @return Index des Blocks innerhalb der Größenklasse oder NO_SLOT, wenn der Zeiger auf keinen Blockanfang zeigt.
+ */
+int heap_find_block(const void* ptr, int* heap_class_index) {
+    for(int i=0; i<shm_ptr->heap_classes; i++) {
+        heap_class* heap = &(shm_ptr->heap[i]);
+        const char* first_block = (const char*)shm_ptr + heap->blocks_offset;
+        if((const char*)ptr < first_block) {
+            continue;
+        }
+        size_t offset = (size_t)((const char*)ptr - first_block);
+        if(offset / (size_t)heap->block_size >= (size_t)heap->block_count) {
+            continue;
+        }
+        if(offset % (size_t)heap->block_size != 0) {
+            return NO_SLOT;
+        }
+        *heap_class_index = i;
+        return (int)(offset / (size_t)heap->block_size);
     }
+    return NO_SLOT;
+}
 
-    // Mappe zunächst nur die feste Größe des Shared Memory, um die Anzahl der Prozesse auszulesen
-    shm_ptr = mmap(NULL, (size_t)sizeof(shared_memory), PROT_READ | PROT_WRITE, MAP_SHARED, shared_memory_fd, 0);
-    int processes;
-    processes = shm_ptr->size;
-    // Unmap
-    munmap(shm_ptr, (int)sizeof(shared_memory));
-
-    // Berechne die tatsächliche Größe des Shared Memory
-    memory_size = calculate_shared_memory_size(processes);
-    // Mappe neu mit der passenden Größe
-    shm_ptr = mmap(NULL, (size_t)memory_size, PROT_READ | PROT_WRITE, MAP_SHARED, shared_memory_fd, 0);
+/**
+ * Liefert einen Zeiger auf die Nutzlast eines Nachrichtenslots.
+ * @param slot_index Index des Nachrichtenslots.
+ * @return Zeiger auf den Heap-Block, der die Nutzlast enthält.
+ */
+char* get_slot_payload(int slot_index) {
+    message_slot* slot = get_slot(slot_index);
+    return get_heap_block(slot->heap_class, slot->block);
+}
 
-    pthread_mutex_lock(&(shm_ptr->initializing_mutex));
+/**
+ * Liefert den kleinsten Wert, unter dem der Empfänger Inline-Nachrichten verwaltet. Darunter liegen die Indizes der
+ * Nachrichtenslots und der Rendezvous-Deskriptoren.
+ * @return Wert der ersten Inline-Nachricht im Zwischenspeicher.
+ */
+int get_inline_base(void) {
+    return shm_ptr->max_slots + OSMP_size * RENDEZVOUS_DESCRIPTORS;
+}
 
-    logging_init_child(shm_ptr);
+/**
+ * Liefert einen Eintrag des Zwischenspeichers für Inline-Nachrichten.
+ * @param index Index des Eintrags.
+ * @return Zeiger auf den Eintrag.
+ */
+inline_message* get_inline_record(int index) {
+    return &inline_blocks[index / INLINE_BLOCK_SIZE][index % INLINE_BLOCK_SIZE];
+}
 
-    log_osmp_lib_call("OSMP_Init");
-    log_to_file(2, "Calloc 256 B (shared_memory_name)");
-    if(shm_ptr == MAP_FAILED){
-        pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
-        pthread_cond_broadcast(&(shm_ptr->initializing_condition));
-        log_to_file(3, "Failed to map shared memory.\n");
-        return OSMP_FAILURE;
+/**
+ * Liefert die Inline-Nachricht, für die ein Wert steht.
+ * @param message Wert aus dem Postfach.
+ * @return Zeiger auf die Nachricht oder NULL, wenn der Wert auf einen Nachrichtenslot oder Rendezvous-Deskriptor
+ * verweist.
+ */
+inline_message* get_inline_message(int message) {
+    int base = get_inline_base();
+    if(message < base) {
+        return NULL;
     }
+    return get_inline_record(message - base);
+}
 
-    for (int i = 0; i < *argc; ++i) {
-        printf("%s ", (*argv)[i]);
+/**
+ * Sichert count freie Einträge im Zwischenspeicher für Inline-Nachrichten, bevor ebenso viele Einträge aus dem
+ * Postfach entnommen werden. Reichen die freien Einträge nicht, werden weitere Blöcke angelegt.
+ * @param count Anzahl der Einträge.
+ * @return OSMP_SUCCESS oder OSMP_FAILURE, wenn der Zwischenspeicher nicht mehr wachsen kann.
+ */
+int reserve_inline_records(int count) {
+    if(__atomic_sub_fetch(&inline_spare, count, __ATOMIC_ACQ_REL) >= 0) {
+        return OSMP_SUCCESS;
     }
-    puts("");
-
-    // Setze globale Variablen
-    OSMP_Size(&OSMP_size);
-
-    int pid = getpid();
-    int size = shm_ptr->size;
-    process_info* process;
-    for(int i=0; i<size; i++) {
-        // Iteriere durch alle Prozesse
-        process = get_process_info(i);
-        if (process->pid == pid) {
-            OSMP_rank = process->rank;
-            process->available = AVAILABLE;
+    pthread_mutex_lock(&inline_mutex);
+    while(__atomic_load_n(&inline_spare, __ATOMIC_ACQUIRE) < 0) {
+        inline_message* block = NULL;
+        if(inline_block_count < INLINE_BLOCKS) {
+            block = malloc(INLINE_BLOCK_SIZE * sizeof(inline_message));
         }
+        if(block == NULL) {
+            __atomic_add_fetch(&inline_spare, count, __ATOMIC_ACQ_REL);
+            pthread_mutex_unlock(&inline_mutex);
+            log_to_file(3, "Failed to allocate memory for inline messages.\n");
+            return OSMP_FAILURE;
+        }
+        int first = inline_block_count * INLINE_BLOCK_SIZE;
+        for(int i = 0; i < INLINE_BLOCK_SIZE; i++) {
+            block[i].next_free = i + 1 < INLINE_BLOCK_SIZE ? first + i + 1 : inline_free;
+        }
+        inline_blocks[inline_block_count++] = block;
+        inline_free = first;
+        __atomic_add_fetch(&inline_spare, INLINE_BLOCK_SIZE, __ATOMIC_ACQ_REL);
     }
-    thread_linked_list_mutex = malloc(sizeof(pthread_mutex_t));
+    pthread_mutex_unlock(&inline_mutex);
+    return OSMP_SUCCESS;
+}
 
-    int mutex_result = pthread_mutex_init(thread_linked_list_mutex, NULL);
-    if(mutex_result < 0){
-        log_to_file(3, "Failed to initialize pthread_mutex_init");
-        return OSMP_FAILURE;
-    }
-    if(OSMP_rank < OSMP_SUCCESS){
-        pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
-        pthread_cond_broadcast(&(shm_ptr->initializing_condition));
-        log_to_file(3, "Couldn't find rank in the shared memory.\n");
-        return OSMP_FAILURE;
-    }
+/**
+ * Gibt gesicherte, aber nicht benötigte Einträge im Zwischenspeicher für Inline-Nachrichten zurück.
+ * @param count Anzahl der Einträge.
+ */
+void release_inline_records(int count) {
+    __atomic_add_fetch(&inline_spare, count, __ATOMIC_ACQ_REL);
+}
 
-    free(shared_memory_name);
-    log_to_file(2, "Free 256 B (shared_memory_name)");
+/**
+ * Kopiert eine Inline-Nachricht aus einem Postfach-Eintrag in den Zwischenspeicher des aufrufenden Prozesses, damit
+ * der Eintrag sofort wieder frei wird. Der Aufrufer muss dafür mit reserve_inline_records() einen Eintrag gesichert
+ * haben.
+ * @param entry Postfach-Eintrag mit der Nachricht.
+ * @return Wert, unter dem die Nachricht wie ein Eintrag aus dem Postfach verwaltet wird.
+ */
+int store_inline_message(const postbox_entry* entry) {
+    pthread_mutex_lock(&inline_mutex);
+    int index = inline_free;
+    inline_message* record = get_inline_record(index);
+    inline_free = record->next_free;
+    pthread_mutex_unlock(&inline_mutex);
+
+    record->source = entry->from;
+    record->tag = entry->tag;
+    record->len = entry->len;
+    memcpy(record->payload, entry->payload, (size_t)entry->len);
+    return get_inline_base() + index;
+}
 
-    pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
-    pthread_cond_broadcast(&(shm_ptr->initializing_condition));
-    return OSMP_SUCCESS;
+/**
+ * Kopiert eine Inline-Nachricht aus dem Zwischenspeicher in einen Puffer und gibt ihren Eintrag frei.
+ * @param message  Wert der Inline-Nachricht.
+ * @param buf      Zielpuffer (darf NULL sein, wenn capacity 0 ist).
+ * @param capacity Größe des Zielpuffers in Bytes; darüber hinausgehende Bytes werden verworfen.
+ */
+void read_inline_message(int message, void *buf, int capacity) {
+    inline_message* record = get_inline_message(message);
+    int to_copy = record->len < capacity ? record->len : capacity;
+    memcpy(buf, record->payload, (size_t)to_copy);
+
+    pthread_mutex_lock(&inline_mutex);
+    record->next_free = inline_free;
+    inline_free = message - get_inline_base();
+    pthread_mutex_unlock(&inline_mutex);
+    release_inline_records(1);
 }
 
-int OSMP_SizeOf(OSMP_Datatype datatype, unsigned int *size) {
-    log_osmp_lib_call("OSMP_SizeOf");
-    if(datatype == OSMP_SHORT){
-        *size = sizeof(short int);
-        return OSMP_SUCCESS;
-    }else if(datatype == OSMP_INT){
-        *size = sizeof(int);
-        return OSMP_SUCCESS;
-    }else if(datatype == OSMP_LONG){
-        *size = sizeof(long int);
-        return OSMP_SUCCESS;
-    }else if(datatype == OSMP_UNSIGNED_CHAR){
-        *size = sizeof(unsigned char);
-        return OSMP_SUCCESS;
-    }else if(datatype == OSMP_UNSIGNED){
-        *size = sizeof(unsigned);
-        return OSMP_SUCCESS;
-    }else if(datatype == OSMP_UNSIGNED_SHORT){
-        *size = sizeof(unsigned short int);
-        return OSMP_SUCCESS;
-    }else if(datatype == OSMP_UNSIGNED_LONG){
-        *size = sizeof(unsigned long int);
-        return OSMP_SUCCESS;
-    }else if(datatype == OSMP_FLOAT){
-        *size = sizeof(float);
-        return OSMP_SUCCESS;
-    }else if(datatype == OSMP_DOUBLE){
-        *size = sizeof(double);
-        return OSMP_SUCCESS;
-    }else if(datatype == OSMP_BYTE){
-        *size = sizeof(char );
-        return OSMP_SUCCESS;
+/**
+ * Liefert den Rendezvous-Deskriptor, auf den ein Postfach-Eintrag verweist.
+ * @param message Wert aus dem Postfach.
+ * @return Zeiger auf den Deskriptor oder NULL, wenn der Eintrag auf einen Nachrichtenslot oder eine Inline-Nachricht
+ * verweist.
+ */
+rendezvous_descriptor* get_rendezvous(int message) {
+    if(message < shm_ptr->max_slots || message >= get_inline_base()) {
+        return NULL;
     }
-    return OSMP_FAILURE;
+    int index = message - shm_ptr->max_slots;
+    return &(get_process_info(index / RENDEZVOUS_DESCRIPTORS)->rendezvous[index % RENDEZVOUS_DESCRIPTORS]);
 }
 
-int OSMP_Size(int *size) {
-    if(gettid() != getpid()){
-        log_to_file(3, "Initializing of threads is not allowed\n");
-        exit(0);
+/**
+ * Liefert den Rang des Senders einer Nachricht aus dem Postfach.
+ * @param message Wert aus dem Postfach.
+ * @return Rang des Senders.
+ */
+int get_message_source(int message) {
+    if(message < shm_ptr->max_slots) {
+        return get_slot(message)->from;
     }
-    *size = shm_ptr->size;
-    return OSMP_SUCCESS;
+    inline_message* record = get_inline_message(message);
+    if(record != NULL) {
+        return record->source;
+    }
+    return (message - shm_ptr->max_slots) / RENDEZVOUS_DESCRIPTORS;
 }
 
-int OSMP_Rank(int *rank) {
-    log_osmp_lib_call("OSMP_Rank");
-    if(gettid() != getpid()){
-        log_to_file(3, "Initializing of threads is not allowed\n");
-        return OSMP_FAILURE;
+/**
+ * Liefert das Tag einer Nachricht aus dem Postfach.
+ * @param message Wert aus dem Postfach.
+ * @return Tag der Nachricht.
+ */
+int get_message_tag(int message) {
+    rendezvous_descriptor* descriptor = get_rendezvous(message);
+    if(descriptor != NULL) {
+        return descriptor->tag;
     }
-    if(OSMP_rank == OSMP_FAILURE){
-        log_to_file(3, "Calling rank before initializing the OSMP_Process.\n");
+    inline_message* record = get_inline_message(message);
+    if(record != NULL) {
+        return record->tag;
     }
-    *rank = OSMP_rank;
-    return OSMP_SUCCESS;
+    return get_slot(message)->tag;
 }
 
-
-int OSMP_Send(const void *buf, int count, OSMP_Datatype datatype, int dest) {
-    log_osmp_lib_call("OSMP_Send");
-    if(count <= 0) {
-        log_to_file(2, "Cant send with count zero or less.\n");
-        return OSMP_FAILURE;
-    }
-    if(dest>=OSMP_size || dest<0){
-        log_to_file(2, "Destination must be between zero and OSMP_size.\n");
-        return OSMP_FAILURE;
+/**
+ * Liefert die Länge einer Nachricht aus dem Postfach in Bytes.
+ * @param message Wert aus dem Postfach.
+ * @return Länge der Nachricht.
+ */
+int get_message_length(int message) {
+    rendezvous_descriptor* descriptor = get_rendezvous(message);
+    if(descriptor != NULL) {
+        return descriptor->len;
     }
-    unsigned int datatype_size;
-    OSMP_SizeOf(datatype, &datatype_size);
-    int length_in_bytes = (int)datatype_size * count;
-    if(length_in_bytes > OSMP_MAX_PAYLOAD_LENGTH) {
-        log_to_file(2, "Cant send more than OSMP_MAX_PAYLOAD_LENGTH bytes.\n");
-        return OSMP_FAILURE;
+    inline_message* record = get_inline_message(message);
+    if(record != NULL) {
+        return record->len;
     }
-    process_info * process_info = get_process_info(dest);
+    return get_slot(message)->len;
+}
 
-    pthread_mutex_lock(&(shm_ptr->initializing_mutex));
-    while (process_info->available == NOT_AVAILABLE){
-        pthread_cond_wait(&(shm_ptr->initializing_condition), &(shm_ptr->initializing_mutex));
-    }
-    pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
-    sem_wait(&process_info->postbox.sem_proc_empty);
-    sem_wait(&shm_ptr->sem_shm_free_slots);
+/**
+ * Liest einen Eintrag aus dem Ringpuffer des aufrufenden Prozesses und gibt ihn für die nächste Runde frei.
+ * Inline-Nachrichten werden dabei in den Zwischenspeicher kopiert.
+ * @param position Reservierte Leseposition.
+ * @return Index des Slots, in dem die Nachricht liegt, oder Wert der Inline-Nachricht.
+ */
+int postbox_take(uint64_t position) {
+    postbox_entry* entry = get_postbox_entry(OSMP_rank, position);
 
-    pthread_mutex_lock(&shm_ptr->mutex_shm_free_slots);
+    // Ein Sender kann seine Position reserviert, aber noch nicht veröffentlicht haben
+    while(__atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE) != position + 1) {
+        sched_yield();
+    }
+    int message = entry->slot == INLINE_ENTRY ? store_inline_message(entry) : entry->slot;
+    entry->slot = NO_MESSAGE;
+    // Eintrag für die nächste Runde freigeben
+    __atomic_store_n(&entry->sequence, position + (uint64_t)shm_ptr->max_messages_proc, __ATOMIC_RELEASE);
+    return message;
+}
 
-    // aktueller Index für das free-slots-Array
-    int list_index = shm_ptr->free_slots_index;
-    // hole Index eines freien Nachrichtenslots
-    int slot_index = shm_ptr->free_slots[list_index];
-    // setze Array an der Stelle auf NO_SLOT
-    shm_ptr->free_slots[list_index] = NO_SLOT;
-    // inkrementiere Index
-    (shm_ptr->free_slots_index)++;
+/**
+ * Entnimmt die Nachricht an der reservierten Leseposition aus dem Ringpuffer des aufrufenden Prozesses.
+ * Die Position muss zuvor über sem_proc_full abgesichert worden sein.
+ * @return Index des Slots, in dem die Nachricht liegt, oder Wert der Inline-Nachricht. INLINE_EXHAUSTED, wenn der
+ *         Zwischenspeicher für Inline-Nachrichten erschöpft ist; die Nachricht bleibt dann im Postfach und
+ *         sem_proc_full wird zurückgegeben.
+ */
+int postbox_dequeue(void) {
+    postbox_utilities* postbox = &get_process_info(OSMP_rank)->postbox;
+    if(reserve_inline_records(1) != OSMP_SUCCESS) {
+        osmp_sem_post(&postbox->sem_proc_full);
+        return INLINE_EXHAUSTED;
+    }
+    uint64_t position = __atomic_fetch_add(&postbox->out_index, 1, __ATOMIC_RELAXED);
+    int message = postbox_take(position);
+    if(message < get_inline_base()) {
+        release_inline_records(1);
+    }
 
-    pthread_mutex_unlock(&shm_ptr->mutex_shm_free_slots);
+    osmp_sem_post(&postbox->sem_proc_empty);
+    return message;
+}
+
+/**
+ * Entnimmt ohne zu blockieren alle Nachrichten, die im Ringpuffer des aufrufenden Prozesses liegen, höchstens aber max.
+ * Die Einträge werden gemeinsam reserviert und gemeinsam für die Sender freigegeben.
+ * @param messages Feld für die entnommenen Werte (mindestens max Einträge).
+ * @param max      Höchstzahl der zu entnehmenden Nachrichten.
+ * @return Anzahl der entnommenen Nachrichten.
+ */
+int postbox_dequeue_many(int* messages, int max) {
+    postbox_utilities* postbox = &get_process_info(OSMP_rank)->postbox;
+    int count = osmp_sem_trywait_many(&postbox->sem_proc_full, max);
+    if(count == 0) {
+        return 0;
+    }
+    // Ohne Platz im Zwischenspeicher bleiben die Nachrichten im Postfach
+    if(reserve_inline_records(count) != OSMP_SUCCESS) {
+        osmp_sem_post_many(&postbox->sem_proc_full, count);
+        return 0;
+    }
+
+    uint64_t position = __atomic_fetch_add(&postbox->out_index, (uint64_t)count, __ATOMIC_RELAXED);
+    int stored = 0;
+    for(int i = 0; i < count; i++, position++) {
+        messages[i] = postbox_take(position);
+        stored += messages[i] >= get_inline_base();
+    }
+    release_inline_records(count - stored);
+
+    osmp_sem_post_many(&postbox->sem_proc_empty, count);
+    return count;
+}
+
+/**
+ * Meldet einem Prozess ein Ereignis, falls dieser sein Eventfd mit OSMP_GetEventFd() abgefragt hat. Nur der Übergang
+ * von EVENT_IDLE zu EVENT_PENDING weckt seinen Überwachungsthread; bis dieser das Eventfd signalisiert hat, kosten
+ * weitere Ereignisse keinen Systemaufruf.
+ * @param rank Rang des Prozesses.
+ */
+void signal_event(int rank) {
+    process_info* info = get_process_info(rank);
+    // Zusammen mit der Reihenfolge in OSMP_GetEventFd() und OSMP_thread_event() geht keine Nachricht verloren
+    if(!__atomic_load_n(&info->event_armed, __ATOMIC_SEQ_CST)
+       || __atomic_load_n(&info->event_pending, __ATOMIC_SEQ_CST) != EVENT_IDLE) {
+        return;
+    }
+    int idle = EVENT_IDLE;
+    if(__atomic_compare_exchange_n(&info->event_pending, &idle, EVENT_PENDING, 0, __ATOMIC_SEQ_CST,
+                                   __ATOMIC_RELAXED)) {
+        osmp_wake_all(&info->event_pending);
+    }
+}
+
+/**
+ * Überwachungsthread des Eventfds. Wartet auf gemeldete Ereignisse und signalisiert für jede Meldung einmal das
+ * Eventfd, bis OSMP_Finalize() EVENT_STOP setzt. So muss kein Sender das Eventfd eines anderen Prozesses kennen.
+ * @param args Unbenutzt.
+ * @return NULL.
+ */
+void * OSMP_thread_event(void* args) {
+    (void) args;
+    log_osmp_lib_call("OSMP_thread_event");
+    process_info* info = get_process_info(OSMP_rank);
+    while(1) {
+        osmp_wait_while_equal(&info->event_pending, EVENT_IDLE);
+        // Erst zurücksetzen, dann signalisieren: Ein späteres Ereignis weckt den Thread erneut
+        int pending = EVENT_PENDING;
+        if(!__atomic_compare_exchange_n(&info->event_pending, &pending, EVENT_IDLE, 0, __ATOMIC_SEQ_CST,
+                                        __ATOMIC_RELAXED)) {
+            break;
+        }
+        uint64_t one = 1;
+        if(write(event_fd, &one, sizeof(one)) != (ssize_t)sizeof(one)) {
+            log_to_file(2, "Couldn't signal eventfd.\n");
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Beendet den Überwachungsthread des Eventfds und schließt das Eventfd, falls OSMP_GetEventFd() es angelegt hat.
+ */
+void stop_event_thread(void) {
+    if(event_fd == -1) {
+        return;
+    }
+    process_info* info = get_process_info(OSMP_rank);
+    __atomic_store_n(&info->event_armed, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&info->event_pending, EVENT_STOP, __ATOMIC_SEQ_CST);
+    osmp_wake_all(&info->event_pending);
+    pthread_join(event_thread, NULL);
+    close(event_fd);
+    event_fd = -1;
+}
+
+/**
+ * Wartet, bis der Empfänger der vorherigen Runde einen Eintrag im Postfach des angegebenen Prozesses gelesen hat.
+ * @param dest     Rang des Empfängers.
+ * @param position Reservierte Schreibposition.
+ * @return Zeiger auf den Eintrag.
+ */
+postbox_entry* postbox_claim(int dest, uint64_t position) {
+    postbox_entry* entry = get_postbox_entry(dest, position);
+    while(__atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE) != position) {
+        sched_yield();
+    }
+    return entry;
+}
+
+/**
+ * Veröffentlicht einen gefüllten Eintrag für den Empfänger.
+ * @param entry    Eintrag, der mit postbox_claim() reserviert wurde.
+ * @param position Schreibposition des Eintrags.
+ */
+void postbox_publish(postbox_entry* entry, uint64_t position) {
+    __atomic_store_n(&entry->sequence, position + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Schreibt eine Nachricht bis INLINE_PAYLOAD_LENGTH Bytes direkt in einen reservierten Postfach-Eintrag.
+ * @param entry           Eintrag, der mit postbox_claim() reserviert wurde.
+ * @param buf             Nutzlast der Nachricht.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param tag             Tag der Nachricht.
+ */
+void fill_inline_entry(postbox_entry* entry, const void* buf, int length_in_bytes, int tag) {
+    entry->slot = INLINE_ENTRY;
+    entry->from = OSMP_rank;
+    entry->tag = tag;
+    entry->len = length_in_bytes;
+    memcpy(entry->payload, buf, (size_t)length_in_bytes);
+}
+
+/**
+ * Legt den Index eines Nachrichtenslots im Postfach des angegebenen Prozesses ab. Der Platz im Postfach muss bereits
+ * über sem_proc_empty reserviert sein.
+ * @param dest       Rang des Empfängers.
+ * @param slot_index Index des Nachrichtenslots.
+ */
+void postbox_put(int dest, int slot_index) {
+    postbox_utilities* postbox = &get_process_info(dest)->postbox;
+    uint64_t position = __atomic_fetch_add(&postbox->in_index, 1, __ATOMIC_RELAXED);
+    postbox_entry* entry = postbox_claim(dest, position);
+    entry->slot = slot_index;
+    postbox_publish(entry, position);
+
+    osmp_sem_post(&postbox->sem_proc_full);
+    signal_event(dest);
+}
+
+/**
+ * Legt eine Nachricht bis INLINE_PAYLOAD_LENGTH Bytes direkt im Postfach des angegebenen Prozesses ab. Der Platz im
+ * Postfach muss bereits über sem_proc_empty reserviert sein.
+ * @param dest            Rang des Empfängers.
+ * @param buf             Nutzlast der Nachricht.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param tag             Tag der Nachricht.
+ */
+void postbox_put_inline(int dest, const void* buf, int length_in_bytes, int tag) {
+    postbox_utilities* postbox = &get_process_info(dest)->postbox;
+    uint64_t position = __atomic_fetch_add(&postbox->in_index, 1, __ATOMIC_RELAXED);
+    postbox_entry* entry = postbox_claim(dest, position);
+    fill_inline_entry(entry, buf, length_in_bytes, tag);
+    postbox_publish(entry, position);
+
+    osmp_sem_post(&postbox->sem_proc_full);
+    signal_event(dest);
+}
+
+/**
+ * Legt den Index eines Nachrichtenslots im Postfach des angegebenen Prozesses ab. Blockiert nur, wenn das Postfach
+ * voll ist.
+ * @param dest       Rang des Empfängers.
+ * @param slot_index Index des Nachrichtenslots.
+ */
+void postbox_enqueue(int dest, int slot_index) {
+    osmp_sem_wait(&get_process_info(dest)->postbox.sem_proc_empty);
+    postbox_put(dest, slot_index);
+}
+
+/**
+ * Legt eine Nachricht bis INLINE_PAYLOAD_LENGTH Bytes direkt im Postfach des angegebenen Prozesses ab, ohne einen
+ * Nachrichtenslot zu belegen. Blockiert nur, wenn das Postfach voll ist.
+ * @param dest            Rang des Empfängers.
+ * @param buf             Nutzlast der Nachricht.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param tag             Tag der Nachricht.
+ */
+void postbox_enqueue_inline(int dest, const void* buf, int length_in_bytes, int tag) {
+    osmp_sem_wait(&get_process_info(dest)->postbox.sem_proc_empty);
+    postbox_put_inline(dest, buf, length_in_bytes, tag);
+}
+
+/**
+ * Legt mehrere Werte in dieser Reihenfolge im Postfach des angegebenen Prozesses ab. Die Einträge werden gemeinsam
+ * reserviert, und der Empfänger wird für alle gleichzeitig veröffentlichten Einträge nur einmal geweckt. Blockiert nur,
+ * wenn das Postfach voll ist; bis dahin reservierte Einträge werden vorher veröffentlicht.
+ * @param dest     Rang des Empfängers.
+ * @param messages Werte für das Postfach (Indizes von Nachrichtenslots).
+ * @param count    Anzahl der Werte.
+ */
+void postbox_enqueue_many(int dest, const int* messages, int count) {
+    postbox_utilities* postbox = &get_process_info(dest)->postbox;
+    int published = 0;
+    while(published < count) {
+        int reserved = osmp_sem_wait_many(&postbox->sem_proc_empty, count - published);
+
+        uint64_t position = __atomic_fetch_add(&postbox->in_index, (uint64_t)reserved, __ATOMIC_RELAXED);
+        for(int i = 0; i < reserved; i++, position++) {
+            postbox_entry* entry = postbox_claim(dest, position);
+            entry->slot = messages[published + i];
+            postbox_publish(entry, position);
+        }
+
+        osmp_sem_post_many(&postbox->sem_proc_full, reserved);
+        signal_event(dest);
+        published += reserved;
+    }
+}
+
+/**
+ * Gibt den Index des Nachrichtenslots zurück, in dem die nächste Nachricht für den aufrufenden Prozess liegt.
+ * Blockiert, solange das Postfach leer ist.
+ * @return Index des Slots, in dem die nächste Nachricht für den aufrufenden Prozess liegt, oder INLINE_EXHAUSTED.
+ */
+int get_next_message(void ) {
+    log_osmp_lib_call("get_next_message");
+    process_info* process = get_process_info(OSMP_rank);
+
+    osmp_sem_wait(&process->postbox.sem_proc_full);
+    return postbox_dequeue();
+}
+
+/**
+ * Liefert, ob der aufrufende Prozess gerade einen Empfangspuffer bereitgestellt hat. Solange das der Fall ist, leert
+ * nur der Hilfsthread für Empfänge das Postfach, damit eine direkt geschriebene Nachricht keine ältere desselben
+ * Senders überholt. Der Aufrufer muss pending_mutex halten.
+ * @return 1, wenn ein Empfangspuffer bereitgestellt ist, sonst 0.
+ */
+int posted_receive_active(void) {
+    return __atomic_load_n(&get_process_info(OSMP_rank)->posted.state, __ATOMIC_ACQUIRE) != POSTED_IDLE;
+}
+
+/**
+ * Gibt den Index des Nachrichtenslots zurück, in dem die nächste Nachricht für den aufrufenden Prozess liegt, ohne
+ * zu blockieren.
+ * @return Index des Slots oder NO_MESSAGE, wenn das Postfach leer ist.
+ */
+int try_get_next_message(void) {
+    log_osmp_lib_call("try_get_next_message");
+    process_info* process = get_process_info(OSMP_rank);
+
+    if(posted_receive_active() || osmp_sem_trywait(&process->postbox.sem_proc_full) != OSMP_SUCCESS) {
+        return NO_MESSAGE;
+    }
+    int message = postbox_dequeue();
+    return message == INLINE_EXHAUSTED ? NO_MESSAGE : message;
+}
+
+/**
+ * Prüft, ob eine Nachricht zu den Suchkriterien eines Empfangsaufrufs passt.
+ * @param source Rang des Senders der Nachricht.
+ * @param tag    Tag der Nachricht.
+ * @param wanted_source Gesuchter Sender oder OSMP_ANY_SOURCE.
+ * @param wanted_tag    Gesuchtes Tag oder OSMP_ANY_TAG.
+ * @return 1, wenn die Nachricht passt, sonst 0.
+ */
+int message_matches(int source, int tag, int wanted_source, int wanted_tag) {
+    return (wanted_source == OSMP_ANY_SOURCE || wanted_source == source) &&
+           (wanted_tag == OSMP_ANY_TAG || wanted_tag == tag);
+}
+
+/**
+ * Hängt eine aus dem Postfach entnommene Nachricht an die Liste ihres Senders und an die Ankunftsliste an.
+ * Der Aufrufer muss pending_mutex halten.
+ * @param message Wert aus dem Postfach.
+ */
+void pending_append(int message) {
+    // Jeder Wert aus dem Postfach ist eindeutig, solange die Nachricht nicht empfangen wurde; Inline-Nachrichten
+    // bringen ihren Knoten im Zwischenspeicher mit
+    inline_message* record = get_inline_message(message);
+    pending_message* node = record != NULL ? &record->node : &pending_nodes[message];
+    node->message = message;
+    node->source = get_message_source(message);
+    node->tag = get_message_tag(message);
+
+    node->next_arrival = NULL;
+    node->prev_arrival = arrival_last;
+    if(arrival_last != NULL) {
+        arrival_last->next_arrival = node;
+    } else {
+        arrival_first = node;
+    }
+    arrival_last = node;
+
+    node->next_source = NULL;
+    node->prev_source = pending_last[node->source];
+    if(pending_last[node->source] != NULL) {
+        pending_last[node->source]->next_source = node;
+    } else {
+        pending_first[node->source] = node;
+    }
+    pending_last[node->source] = node;
+}
+
+/**
+ * Entfernt eine wartende Nachricht aus beiden Listen. Der Aufrufer muss pending_mutex halten.
+ * @param node Knoten der Nachricht.
+ */
+void pending_remove(pending_message* node) {
+    if(node->prev_arrival != NULL) {
+        node->prev_arrival->next_arrival = node->next_arrival;
+    } else {
+        arrival_first = node->next_arrival;
+    }
+    if(node->next_arrival != NULL) {
+        node->next_arrival->prev_arrival = node->prev_arrival;
+    } else {
+        arrival_last = node->prev_arrival;
+    }
+
+    if(node->prev_source != NULL) {
+        node->prev_source->next_source = node->next_source;
+    } else {
+        pending_first[node->source] = node->next_source;
+    }
+    if(node->next_source != NULL) {
+        node->next_source->prev_source = node->prev_source;
+    } else {
+        pending_last[node->source] = node->prev_source;
+    }
+}
+
+/**
+ * Sucht die älteste wartende Nachricht, die zu den Suchkriterien passt. Mit einem festen Sender wird nur dessen
+ * Liste durchsucht. Der Aufrufer muss pending_mutex halten.
+ * @param source Gesuchter Sender oder OSMP_ANY_SOURCE.
+ * @param tag    Gesuchtes Tag oder OSMP_ANY_TAG.
+ * @return Knoten der Nachricht oder NULL, wenn keine passende Nachricht wartet.
+ */
+pending_message* pending_find(int source, int tag) {
+    if(source == OSMP_ANY_SOURCE) {
+        pending_message* node = arrival_first;
+        while(node != NULL && !message_matches(node->source, node->tag, source, tag)) {
+            node = node->next_arrival;
+        }
+        return node;
+    }
+
+    pending_message* node = pending_first[source];
+    while(node != NULL && !message_matches(node->source, node->tag, source, tag)) {
+        node = node->next_source;
+    }
+    return node;
+}
+
+/**
+ * Liefert die älteste Nachricht, die zu den Suchkriterien passt. Blockiert, bis eine passende Nachricht eintrifft.
+ * Von allen wartenden Threads liest immer nur einer das Postfach und legt unpassende Nachrichten für die anderen ab.
+ * @param source Gesuchter Sender oder OSMP_ANY_SOURCE.
+ * @param tag    Gesuchtes Tag oder OSMP_ANY_TAG.
+ * @param remove 1, um die Nachricht aus der Verwaltung zu nehmen; 0, um sie für einen späteren Empfang zu behalten.
+ * @return Wert aus dem Postfach oder INLINE_EXHAUSTED, wenn der Zwischenspeicher für Inline-Nachrichten erschöpft ist.
+ */
+int find_matching_message(int source, int tag, int remove) {
+    log_osmp_lib_call("find_matching_message");
+    pthread_mutex_lock(&pending_mutex);
+    pending_message* node = pending_find(source, tag);
+    while(node == NULL) {
+        if(pending_draining) {
+            pthread_cond_wait(&pending_condition, &pending_mutex);
+        } else {
+            pending_draining = 1;
+            pthread_mutex_unlock(&pending_mutex);
+            int message = get_next_message();
+            pthread_mutex_lock(&pending_mutex);
+            pending_draining = 0;
+
+            if(message == INLINE_EXHAUSTED) {
+                pthread_cond_broadcast(&pending_condition);
+                pthread_mutex_unlock(&pending_mutex);
+                return INLINE_EXHAUSTED;
+            }
+
+            // Passende Nachrichten werden direkt zurückgegeben, ohne sie erst abzulegen
+            if(remove && message_matches(get_message_source(message), get_message_tag(message), source, tag)) {
+                pthread_cond_broadcast(&pending_condition);
+                pthread_mutex_unlock(&pending_mutex);
+                return message;
+            }
+            pending_append(message);
+            pthread_cond_broadcast(&pending_condition);
+        }
+        node = pending_find(source, tag);
+    }
+    if(remove) {
+        pending_remove(node);
+    }
+    pthread_mutex_unlock(&pending_mutex);
+    return node->message;
+}
+
+/**
+ * Liefert die älteste Nachricht, die zu den Suchkriterien passt, ohne zu blockieren.
+ * @param source Gesuchter Sender oder OSMP_ANY_SOURCE.
+ * @param tag    Gesuchtes Tag oder OSMP_ANY_TAG.
+ * @param remove 1, um die Nachricht aus der Verwaltung zu nehmen; 0, um sie für einen späteren Empfang zu behalten.
+ * @return Wert aus dem Postfach oder NO_MESSAGE, wenn keine passende Nachricht vorliegt.
+ */
+int try_find_matching_message(int source, int tag, int remove) {
+    log_osmp_lib_call("try_find_matching_message");
+    pthread_mutex_lock(&pending_mutex);
+
+    // Alle bereits eingetroffenen Nachrichten übernehmen
+    int message = try_get_next_message();
+    if(message != NO_MESSAGE) {
+        while(message != NO_MESSAGE) {
+            pending_append(message);
+            message = try_get_next_message();
+        }
+        pthread_cond_broadcast(&pending_condition);
+    }
+
+    pending_message* node = pending_find(source, tag);
+    if(node != NULL) {
+        if(remove) {
+            pending_remove(node);
+        }
+        message = node->message;
+    }
+    pthread_mutex_unlock(&pending_mutex);
+    return message;
+}
+
+/**
+ * Entnimmt ohne zu blockieren alle vorliegenden Nachrichten in Ankunftsreihenfolge, höchstens aber max: zuerst die
+ * bereits zwischengespeicherten, dann die im Postfach liegenden.
+ * @param messages Feld für die entnommenen Werte (mindestens max Einträge).
+ * @param max      Höchstzahl der zu entnehmenden Nachrichten.
+ * @return Anzahl der entnommenen Nachrichten.
+ */
+int take_queued_messages(int* messages, int max) {
+    log_osmp_lib_call("take_queued_messages");
+    pthread_mutex_lock(&pending_mutex);
+    int count = 0;
+    while(count < max && arrival_first != NULL) {
+        messages[count++] = arrival_first->message;
+        pending_remove(arrival_first);
+    }
+    if(count < max && !posted_receive_active()) {
+        count += postbox_dequeue_many(messages + count, max - count);
+    }
+    pthread_mutex_unlock(&pending_mutex);
+    return count;
+}
+
+/**
+ * Liefert die Semaphore, über die Slots mit der angegebenen Herkunft vergeben werden.
+ * @param credit_owner Rang des Senders, aus dessen Reservierung ein Slot stammt, oder SHARED_CREDIT.
+ * @return Zeiger auf die Semaphore der Reservierung bzw. des gemeinsamen Vorrats.
+ */
+osmp_sem* get_credit_semaphore(int credit_owner) {
+    if(credit_owner == SHARED_CREDIT) {
+        return &shm_ptr->sem_shm_free_slots;
+    }
+    return &get_process_info(credit_owner)->sem_credits;
+}
+
+/**
+ * Nimmt ohne zu blockieren bis zu max Berechtigungen für Nachrichtenslots, zuerst aus der Reservierung des aufrufenden
+ * Prozesses und dann aus dem gemeinsamen Vorrat.
+ * @param max      Höchstzahl der Berechtigungen.
+ * @param reserved Anzahl der Berechtigungen, die aus der Reservierung stammen.
+ * @return Anzahl der Berechtigungen (0 bis max).
+ */
+int try_take_slot_credits(int max, int* reserved) {
+    *reserved = osmp_sem_trywait_many(&get_process_info(OSMP_rank)->sem_credits, max);
+    return *reserved + osmp_sem_trywait_many(&shm_ptr->sem_shm_free_slots, max - *reserved);
+}
+
+/**
+ * Nimmt bis zu max Berechtigungen für Nachrichtenslots, zuerst aus der Reservierung des aufrufenden Prozesses und
+ * dann aus dem gemeinsamen Vorrat. Sind beide erschöpft, wird auf die Rückgabe eines reservierten Slots gewartet; nur
+ * ohne Reservierung (mehr Prozesse als Slots) wird auf den gemeinsamen Vorrat gewartet.
+ * @param max      Höchstzahl der Berechtigungen (mindestens 1).
+ * @param reserved Anzahl der Berechtigungen, die aus der Reservierung stammen. Sie gehören zu den ersten Slots, die
+ *                 danach vom Stapel genommen werden.
+ * @return Anzahl der Berechtigungen (1 bis max).
+ */
+int take_slot_credits(int max, int* reserved) {
+    int taken = try_take_slot_credits(max, reserved);
+    if(taken > 0) {
+        return taken;
+    }
+    osmp_sem* own = &get_process_info(OSMP_rank)->sem_credits;
+    if(shm_ptr->reserved_slots > 0) {
+        *reserved = osmp_sem_wait_many(own, max);
+        return *reserved;
+    }
+    return osmp_sem_wait_many(&shm_ptr->sem_shm_free_slots, max);
+}
+
+/**
+ * Gibt einen gelesenen Nachrichtenslot an die Liste der freien Slots und seine Berechtigung an ihre Herkunft zurück.
+ * @param slot_index Index des freizugebenden Nachrichtenslots.
+ */
+void release_slot(int slot_index) {
+    log_osmp_lib_call("release_slot");
+    // Die Nutzlast wird nicht geleert, da nur die ersten len Bytes eines Blocks gelesen werden
+    message_slot* slot = get_slot(slot_index);
+    get_heap_owner(slot->heap_class)[slot->block] = NO_SLOT;
+    heap_free(slot->heap_class, slot->block, slot->block_owner);
+
+    // Die Herkunft muss vor dem Zurücklegen gelesen werden, da der Slot danach sofort neu vergeben werden kann
+    int credit_owner = slot->credit_owner;
+    tagged_stack_push(&shm_ptr->free_slots, get_next_free_slots(), slot_index);
+    osmp_sem_post(get_credit_semaphore(credit_owner));
+}
+
+/**
+ * Gibt mehrere gelesene Nachrichtenslots gemeinsam an die Liste der freien Slots zurück. Aufeinanderfolgende Slots
+ * derselben Herkunft werden mit einer Operation zurückgelegt und ihre Berechtigungen gemeinsam zurückgegeben.
+ * @param slots Indizes der freizugebenden Nachrichtenslots.
+ * @param count Anzahl der Nachrichtenslots.
+ */
+void release_slots(const int* slots, int count) {
+    log_osmp_lib_call("release_slots");
+    int start = 0;
+    while(start < count) {
+        int credit_owner = get_slot(slots[start])->credit_owner;
+        int end = start;
+        while(end < count && get_slot(slots[end])->credit_owner == credit_owner) {
+            message_slot* slot = get_slot(slots[end]);
+            get_heap_owner(slot->heap_class)[slot->block] = NO_SLOT;
+            heap_free(slot->heap_class, slot->block, slot->block_owner);
+            end++;
+        }
+        tagged_stack_push_many(&shm_ptr->free_slots, get_next_free_slots(), slots + start, end - start);
+        osmp_sem_post_many(get_credit_semaphore(credit_owner), end - start);
+        start = end;
+    }
+}
+
+/**
+ * Setzt die globalen Variablen der OSMP-Bibliothek für den Elternprozess.
+ * @param fd    Shared-Memory-File-Descriptor.
+ * @param shm   Zeiger auf den Beginn des Shared Memory.
+ * @param size  Größe des Shared Memory in Bytes.
+ */
+void OSMP_Init_Runner(int fd, shared_memory* shm, int size) {
+    shared_memory_fd = fd;
+    memory_size = size;
+    shm_ptr = shm;
+    OSMP_Size(&OSMP_size);
+    memory_layout(shm_ptr->size, shm_ptr->max_slots, shm_ptr->max_messages_proc, &offsets);
+}
+
+/**
+ * Berechnet die Lage der Bereiche hinter den Prozess-Infos, deren Größe von der Konfiguration abhängt.
+ * @param processes     Die Anzahl der Executable-Prozesse, die verwaltet werden.
+ * @param slots         Anzahl der Nachrichtenslots.
+ * @param messages_proc Tiefe der Postfächer.
+ * @param offsets       Struct, in das die Offsets der Bereiche geschrieben werden.
+ * @return Offset, an dem der Heap beginnt.
+ */
+size_t memory_layout(int processes, int slots, int messages_proc, memory_offsets* offsets) {
+    size_t offset = sizeof(shared_memory);
+    // Das Struct enthält bereits Speicher für einen Prozess; nur der nötige Speicher für die weiteren n-1 Prozesse muss
+    // noch addiert werden.
+    offset += (size_t)(processes-1) * sizeof(process_info);
+
+    offset = align_to_cache_line(offset);
+    offsets->next_free_slot = offset;
+    offset += (size_t)slots * sizeof(int);
+
+    offset = align_to_cache_line(offset);
+    offsets->slots = offset;
+    offset += (size_t)slots * sizeof(message_slot);
+
+    offset = align_to_cache_line(offset);
+    offsets->postbox_entries = offset;
+    // Jedes Postfach beginnt auf einer eigenen Cache-Line
+    offsets->postbox_stride = align_to_cache_line((size_t)messages_proc * sizeof(postbox_entry));
+    offset += (size_t)processes * offsets->postbox_stride;
+
+    offsets->heap = offset;
+    return offset;
+}
+
+/**
+ * Berechnet den für den Shared Memory benötigten Speicherplatz in Abhängigkeit von der Anzahl der Prozesse und der
+ * Konfiguration der Nachrichtenslots.
+ * @param processes      Die Anzahl der Executable-Prozesse, die verwaltet werden.
+ * @param slots          Anzahl der Nachrichtenslots.
+ * @param messages_proc  Tiefe der Postfächer.
+ * @param payload_length Maximale Nutzlast eines Nachrichtenslots in Bytes.
+ * @return Die Größe des benötigten Speicherplatzes in Bytes oder -1, wenn sie nicht als int darstellbar ist.
+ */
+int calculate_shared_memory_size(int processes, int slots, int messages_proc, int payload_length) {
+    memory_offsets layout;
+    size_t size = memory_layout(processes, slots, messages_proc, &layout);
+    // Dahinter liegt der Heap mit den Inhalten der Nachrichten
+    size = heap_layout(NULL, NULL, size, processes, slots, payload_length);
+    if(size > INT_MAX) {
+        return -1;
+    }
+    return (int)size;
+}
+
+/**
+ * Interne Implementierung der OSMP_Barrier()-Funktion. Der letzte ankommende Prozess setzt den Zähler zurück und
+ * erhöht die Zyklusnummer; alle anderen warten mit osmp_wait_while_equal(), bis sich die Zyklusnummer ändert.
+ * @param barrier Zeiger auf die Barriere, an der gewartet werden soll.
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE.
+ */
+int barrier_wait(barrier_t* barrier) {
+    log_osmp_lib_call("barrier_wait");
+    // Thread-Safety:
+    if(getpid()!=gettid()) {
+        log_to_file(3, "Thread calling barrier.");
+        return OSMP_FAILURE;
+    }
+
+    if(barrier->valid != BARRIER_VALID) {
+        log_to_file(3, "Barrier not yet initialized, can't wait at barrier!");
+        return OSMP_FAILURE;
+    }
+
+    // Aktuellen Zyklus merken, bevor der Zähler verringert wird
+    int cycle = __atomic_load_n(&barrier->cycle, __ATOMIC_ACQUIRE);
+
+    if(__atomic_sub_fetch(&barrier->counter, 1, __ATOMIC_ACQ_REL) == 0) {
+        // Der letzte Prozess in der Barriere initialisiert die Barrier für den nächsten Durchlauf.
+        __atomic_store_n(&barrier->counter, OSMP_size, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&barrier->cycle, 1, __ATOMIC_RELEASE);
+        osmp_wake_all(&barrier->cycle);
+    } else {
+        osmp_wait_while_equal(&barrier->cycle, cycle);
+    }
+    return OSMP_SUCCESS;
+}
+
+/**
+ * Legt die Warteschlangen der Progress-Engine an. Ihre Hilfsthreads werden erst beim ersten Bedarf gestartet.
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int init_progress_engine(void) {
+    progress_queues = calloc((size_t)OSMP_size + 1, sizeof(progress_queue));
+    if(progress_queues == NULL) {
+        return OSMP_FAILURE;
+    }
+    return OSMP_SUCCESS;
+}
+
+int OSMP_Init(const int *argc, char ***argv) {
+    if(gettid() != getpid()){
+        printf("Initializing of threads is not allowed\n");
+        exit(0);
+    }
+    char *shared_memory_name;
+    OSMP_GetSharedMemoryName(&shared_memory_name);
+    // Hat osmp_run den Shared Memory mit Huge Pages angelegt (-H), liegt er im hugetlbfs, sonst unter /dev/shm
+    char *huge_page_path = get_huge_page_path(shared_memory_name);
+    shared_memory_fd = open(huge_page_path, O_RDWR);
+    free(huge_page_path);
+    huge_page_segment = shared_memory_fd != -1;
+    if(shared_memory_fd == -1) {
+        shared_memory_fd = shm_open(shared_memory_name, O_RDWR, 0666);
+    }
+    if(shared_memory_fd == -1){
+        printf("Failed to open shared memory.\n");
+        return OSMP_FAILURE;
+    }
+
+    // Mappe zunächst nur die feste Größe des Shared Memory, um die Anzahl der Prozesse und die Konfiguration der
+    // Nachrichtenslots auszulesen
+    shm_ptr = mmap(NULL, (size_t)sizeof(shared_memory), PROT_READ | PROT_WRITE, MAP_SHARED, shared_memory_fd, 0);
+    int processes = shm_ptr->size;
+    int slots = shm_ptr->max_slots;
+    int messages_proc = shm_ptr->max_messages_proc;
+    int payload_length = shm_ptr->max_payload_length;
+    // Unmap
+    munmap(shm_ptr, get_mapping_length(sizeof(shared_memory), huge_page_segment));
+
+    // Berechne die tatsächliche Größe und die Lage der Bereiche des Shared Memory
+    memory_size = calculate_shared_memory_size(processes, slots, messages_proc, payload_length);
+    if(memory_size < 0) {
+        printf("Shared memory is too large for this configuration.\n");
+        return OSMP_FAILURE;
+    }
+    memory_layout(processes, slots, messages_proc, &offsets);
+    // Mappe neu mit der passenden Größe
+    shm_ptr = mmap(NULL, (size_t)memory_size, PROT_READ | PROT_WRITE, MAP_SHARED, shared_memory_fd, 0);
+    if(shm_ptr == MAP_FAILED) {
+        printf("Failed to map shared memory.\n");
+        return OSMP_FAILURE;
+    }
+
+    pthread_mutex_lock(&(shm_ptr->initializing_mutex));
+
+    logging_init_child(shm_ptr);
+
+    log_osmp_lib_call("OSMP_Init");
+    log_to_file(2, "Calloc 256 B (shared_memory_name)");
+
+    for (int i = 0; i < *argc; ++i) {
+        printf("%s ", (*argv)[i]);
+    }
+    puts("");
+
+    // Setze globale Variablen
+    OSMP_Size(&OSMP_size);
+    osmp_sync_set_spin_budget(shm_ptr->spin_budget);
+
+    // Erlaube osmp_run und damit allen OSMP-Prozessen, die seine Nachfahren sind, per process_vm_readv() und
+    // process_vm_writev() auf den Adressraum zuzugreifen. Ohne Yama-LSM schlägt der Aufruf mit EINVAL fehl, ist dann
+    // aber auch nicht nötig. Scheitert er aus einem anderen Grund, gehen alle Nachrichten über die Nachrichtenslots.
+    if(prctl(PR_SET_PTRACER, (unsigned long)getppid(), 0, 0, 0) == -1 && errno != EINVAL) {
+        log_to_file(2, "Couldn't permit access for the other processes, falling back to message slots.\n");
+        __atomic_store_n(&rendezvous_disabled, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&direct_disabled, 1, __ATOMIC_RELAXED);
+    }
+
+    int pid = getpid();
+    int size = shm_ptr->size;
+    process_info* process;
+    for(int i=0; i<size; i++) {
+        // Iteriere durch alle Prozesse
+        process = get_process_info(i);
+        if (process->pid == pid) {
+            OSMP_rank = process->rank;
+            __atomic_store_n(&process->available, AVAILABLE, __ATOMIC_RELEASE);
+            osmp_wake_all(&process->available);
+        }
+    }
+    // Ein Knoten pro möglichem Wert im Postfach: alle Nachrichtenslots und alle Rendezvous-Deskriptoren
+    pending_nodes = calloc((size_t)(shm_ptr->max_slots + OSMP_size * RENDEZVOUS_DESCRIPTORS), sizeof(pending_message));
+    pending_first = calloc((size_t)OSMP_size, sizeof(pending_message*));
+    pending_last = calloc((size_t)OSMP_size, sizeof(pending_message*));
+    inline_blocks = calloc(INLINE_BLOCKS, sizeof(inline_message*));
+    if(pending_nodes == NULL || pending_first == NULL || pending_last == NULL || inline_blocks == NULL) {
+        pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
+        log_to_file(3, "Failed to allocate the pending message lists.\n");
+        return OSMP_FAILURE;
+    }
+
+    if(init_progress_engine() != OSMP_SUCCESS) {
+        pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
+        log_to_file(3, "Failed to allocate the progress engine.\n");
+        return OSMP_FAILURE;
+    }
+    if(OSMP_rank < OSMP_SUCCESS){
+        pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
+        log_to_file(3, "Couldn't find rank in the shared memory.\n");
+        return OSMP_FAILURE;
+    }
+
+    free(shared_memory_name);
+    log_to_file(2, "Free 256 B (shared_memory_name)");
+
+    pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
+    return OSMP_SUCCESS;
+}
+
+int OSMP_SizeOf(OSMP_Datatype datatype, unsigned int *size) {
+    log_osmp_lib_call("OSMP_SizeOf");
+    if(datatype == OSMP_SHORT){
+        *size = sizeof(short int);
+        return OSMP_SUCCESS;
+    }else if(datatype == OSMP_INT){
+        *size = sizeof(int);
+        return OSMP_SUCCESS;
+    }else if(datatype == OSMP_LONG){
+        *size = sizeof(long int);
+        return OSMP_SUCCESS;
+    }else if(datatype == OSMP_UNSIGNED_CHAR){
+        *size = sizeof(unsigned char);
+        return OSMP_SUCCESS;
+    }else if(datatype == OSMP_UNSIGNED){
+        *size = sizeof(unsigned);
+        return OSMP_SUCCESS;
+    }else if(datatype == OSMP_UNSIGNED_SHORT){
+        *size = sizeof(unsigned short int);
+        return OSMP_SUCCESS;
+    }else if(datatype == OSMP_UNSIGNED_LONG){
+        *size = sizeof(unsigned long int);
+        return OSMP_SUCCESS;
+    }else if(datatype == OSMP_FLOAT){
+        *size = sizeof(float);
+        return OSMP_SUCCESS;
+    }else if(datatype == OSMP_DOUBLE){
+        *size = sizeof(double);
+        return OSMP_SUCCESS;
+    }else if(datatype == OSMP_BYTE){
+        *size = sizeof(char );
+        return OSMP_SUCCESS;
+    }
+    return OSMP_FAILURE;
+}
+
+int OSMP_Size(int *size) {
+    if(gettid() != getpid()){
+        log_to_file(3, "Initializing of threads is not allowed\n");
+        exit(0);
+    }
+    *size = shm_ptr->size;
+    return OSMP_SUCCESS;
+}
+
+int OSMP_Rank(int *rank) {
+    log_osmp_lib_call("OSMP_Rank");
+    if(gettid() != getpid()){
+        log_to_file(3, "Initializing of threads is not allowed\n");
+        return OSMP_FAILURE;
+    }
+    if(OSMP_rank == OSMP_FAILURE){
+        log_to_file(3, "Calling rank before initializing the OSMP_Process.\n");
+    }
+    *rank = OSMP_rank;
+    return OSMP_SUCCESS;
+}
+
+int get_OSMP_MAX_PAYLOAD_LENGTH(void) {
+    return shm_ptr->max_payload_length;
+}
+
+int get_OSMP_MAX_SLOTS(void) {
+    return shm_ptr->max_slots;
+}
+
+int get_OSMP_MAX_MESSAGES_PROC(void) {
+    return shm_ptr->max_messages_proc;
+}
+
+
+/**
+ * Blockiert, bis der angegebene Prozess OSMP_Init() aufgerufen hat.
+ * @param dest Rang des Prozesses.
+ */
+void wait_until_available(int dest) {
+    process_info * process_info = get_process_info(dest);
+    osmp_wait_while_equal(&process_info->available, NOT_AVAILABLE);
+}
+
+/**
+ * Ermittelt die Größenklasse des Heap-Blocks, der die Nutzlast einer Nachricht in einem Nachrichtenslot aufnimmt.
+ * Große Nachrichten nutzen einen Block der größten Klasse als Ringpuffer für ihre Teilstücke.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @return Index der Größenklasse.
+ */
+int get_slot_heap_class(int length_in_bytes) {
+    int payload_length = shm_ptr->max_payload_length;
+    return get_heap_class(length_in_bytes < payload_length ? length_in_bytes : payload_length);
+}
+
+/**
+ * Füllt den Kopf eines reservierten Nachrichtenslots und ordnet ihm einen bereits reservierten Heap-Block zu.
+ * @param slot_index      Index des reservierten Nachrichtenslots.
+ * @param dest            Rang des Empfängers.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param datatype        OSMP-Typ der Nachricht.
+ * @param tag             Tag der Nachricht.
+ * @param block           Block aus der Größenklasse get_slot_heap_class(length_in_bytes).
+ * @param block_owner     Herkunft der Berechtigung für den Block.
+ */
+void fill_slot_with_block(int slot_index, int dest, int length_in_bytes, OSMP_Datatype datatype, int tag, int block,
+                          int block_owner) {
+    message_slot* slot = get_slot(slot_index);
+    slot->len = length_in_bytes;
+    slot->from = OSMP_rank;
+    slot->dest = dest;
+    slot->type = datatype;
+    slot->tag = tag;
+    slot->heap_class = get_slot_heap_class(length_in_bytes);
+    slot->block = block;
+    slot->block_owner = block_owner;
+    get_heap_owner(slot->heap_class)[block] = BLOCK_OWNER(slot_index, BLOCK_QUEUED);
+}
+
+/**
+ * Füllt den Kopf eines reservierten Nachrichtenslots und reserviert den Heap-Block für seine Nutzlast.
+ * @param slot_index      Index des reservierten Nachrichtenslots.
+ * @param dest            Rang des Empfängers.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param datatype        OSMP-Typ der Nachricht.
+ * @param tag             Tag der Nachricht.
+ */
+void fill_slot(int slot_index, int dest, int length_in_bytes, OSMP_Datatype datatype, int tag) {
+    int block_owner;
+    int block = heap_alloc(get_slot_heap_class(length_in_bytes), &block_owner);
+    fill_slot_with_block(slot_index, dest, length_in_bytes, datatype, tag, block, block_owner);
+}
+
+/**
+ * Nimmt mit einer bereits erhaltenen Berechtigung einen Nachrichtenslot vom Stapel und füllt dessen Kopf.
+ * @param from_reservation 1, wenn die Berechtigung aus der Reservierung des aufrufenden Prozesses stammt, sonst 0.
+ * @param dest             Rang des Empfängers.
+ * @param length_in_bytes  Länge der Nachricht in Bytes.
+ * @param datatype         OSMP-Typ der Nachricht.
+ * @param tag              Tag der Nachricht.
+ * @return Index des Nachrichtenslots.
+ */
+int claim_slot(int from_reservation, int dest, int length_in_bytes, OSMP_Datatype datatype, int tag) {
+    // Die Berechtigung garantiert, dass der Stapel einen freien Slot enthält
+    int slot_index = tagged_stack_pop(&shm_ptr->free_slots, get_next_free_slots());
+    get_slot(slot_index)->credit_owner = from_reservation ? OSMP_rank : SHARED_CREDIT;
+    fill_slot(slot_index, dest, length_in_bytes, datatype, tag);
+    return slot_index;
+}
+
+/**
+ * Wie claim_slot(), blockiert aber nicht, wenn in der Größenklasse der Nachricht kein Heap-Block frei ist.
+ * @param from_reservation 1, wenn die Berechtigung aus der Reservierung des aufrufenden Prozesses stammt, sonst 0.
+ * @param dest             Rang des Empfängers.
+ * @param length_in_bytes  Länge der Nachricht in Bytes.
+ * @param datatype         OSMP-Typ der Nachricht.
+ * @param tag              Tag der Nachricht.
+ * @return Index des Nachrichtenslots oder NO_SLOT, wenn kein Heap-Block frei ist. Die Berechtigung für den Slot
+ *         bleibt dann beim Aufrufer.
+ */
+int try_claim_slot(int from_reservation, int dest, int length_in_bytes, OSMP_Datatype datatype, int tag) {
+    int block_owner;
+    int block = heap_try_alloc(get_slot_heap_class(length_in_bytes), &block_owner);
+    if(block == NO_SLOT) {
+        return NO_SLOT;
+    }
+    int slot_index = tagged_stack_pop(&shm_ptr->free_slots, get_next_free_slots());
+    get_slot(slot_index)->credit_owner = from_reservation ? OSMP_rank : SHARED_CREDIT;
+    fill_slot_with_block(slot_index, dest, length_in_bytes, datatype, tag, block, block_owner);
+    return slot_index;
+}
+
+/**
+ * Reserviert einen Nachrichtenslot für eine Nachricht an den angegebenen Prozess und füllt dessen Kopf.
+ * Blockiert, bis der Empfänger erreichbar und ein Nachrichtenslot frei ist.
+ * @param dest            Rang des Empfängers.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param datatype        OSMP-Typ der Nachricht.
+ * @param tag             Tag der Nachricht.
+ * @return Index des reservierten Nachrichtenslots.
+ */
+int acquire_slot(int dest, int length_in_bytes, OSMP_Datatype datatype, int tag) {
+    log_osmp_lib_call("acquire_slot");
+    wait_until_available(dest);
+    int reserved;
+    take_slot_credits(1, &reserved);
+    return claim_slot(reserved > 0, dest, length_in_bytes, datatype, tag);
+}
+
+/**
+ * Legt einen gefüllten Nachrichtenslot im Postfach seines Empfängers ab.
+ * @param slot_index Index des Nachrichtenslots, der mit acquire_slot() reserviert wurde.
+ */
+void commit_slot(int slot_index) {
+    log_osmp_lib_call("commit_slot");
+    postbox_enqueue(get_slot(slot_index)->dest, slot_index);
+}
+
+/**
+ * Liefert den Eintrag der Block-Zuordnung für den Heap-Block, auf dessen Anfang ein Zeiger zeigt.
+ * @param payload Zeiger auf den Anfang der Nutzlast eines Nachrichtenslots.
+ * @return Zeiger auf den Eintrag oder NULL, wenn der Zeiger auf keinen Blockanfang zeigt.
+ */
+int* get_block_owner_entry(const void* payload) {
+    int heap_class_index;
+    int block = heap_find_block(payload, &heap_class_index);
+    if(block == NO_SLOT) {
+        return NULL;
+    }
+    return &get_heap_owner(heap_class_index)[block];
+}
+
+/**
+ * Ermittelt den Nachrichtenslot, zu dem ein Zeiger auf den Anfang einer Nutzlast gehört.
+ * @param payload Zeiger auf den Anfang der Nutzlast eines Nachrichtenslots.
+ * @return Index des Nachrichtenslots oder NO_SLOT, wenn der Zeiger auf keine belegte Nutzlast zeigt.
+ */
+int get_slot_index(const void* payload) {
+    int* entry = get_block_owner_entry(payload);
+    if(entry == NULL) {
+        return NO_SLOT;
+    }
+    int owner = __atomic_load_n(entry, __ATOMIC_ACQUIRE);
+    return owner == NO_SLOT ? NO_SLOT : BLOCK_OWNER_SLOT(owner);
+}
+
+/**
+ * Wechselt den Zustand eines belegten Heap-Blocks, sofern er sich im erwarteten Zustand befindet. Gleichzeitige oder
+ * wiederholte Aufrufe für denselben Block gelingen daher höchstens einmal.
+ * @param payload Zeiger auf den Anfang der Nutzlast eines Nachrichtenslots.
+ * @param from    Erwarteter Zustand.
+ * @param to      Neuer Zustand.
+ * @return Index des Nachrichtenslots oder NO_SLOT, wenn der Zeiger auf keinen Block im Zustand from zeigt.
+ */
+int change_block_state(const void* payload, int from, int to) {
+    int* entry = get_block_owner_entry(payload);
+    if(entry == NULL) {
+        return NO_SLOT;
+    }
+    int owner = __atomic_load_n(entry, __ATOMIC_ACQUIRE);
+    if(owner == NO_SLOT || owner != BLOCK_OWNER(BLOCK_OWNER_SLOT(owner), from)
+       || !__atomic_compare_exchange_n(entry, &owner, BLOCK_OWNER(BLOCK_OWNER_SLOT(owner), to), 0, __ATOMIC_ACQ_REL,
+                                       __ATOMIC_ACQUIRE)) {
+        return NO_SLOT;
+    }
+    return BLOCK_OWNER_SLOT(owner);
+}
+
+/**
+ * Sendet eine Nachricht per Rendezvous: Im Postfach des Empfängers wird nur ein Deskriptor mit Adresse und Länge
+ * abgelegt, und der Empfänger liest die Nachricht mit process_vm_readv() direkt aus dem Puffer des Senders. Blockiert,
+ * bis der Empfänger die Nachricht gelesen hat.
+ * @param buf             Startadresse der Nachricht.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param datatype        OSMP-Typ der Nachricht.
+ * @param dest            Rang des Empfängers.
+ * @param tag             Tag der Nachricht.
+ * @return OSMP_SUCCESS, wenn der Empfänger die Nachricht gelesen hat; OSMP_FAILURE, wenn kein Deskriptor frei war oder
+ * der Empfänger nicht auf den Adressraum zugreifen konnte. Die Nachricht muss dann über einen Slot gesendet werden.
+ */
+int send_rendezvous(const void *buf, int length_in_bytes, OSMP_Datatype datatype, int dest, int tag) {
+    log_osmp_lib_call("send_rendezvous");
+    if(__atomic_load_n(&rendezvous_disabled, __ATOMIC_RELAXED)) {
+        return OSMP_FAILURE;
+    }
+
+    // Freien Deskriptor suchen; mehrere Threads des Prozesses können gleichzeitig senden
+    process_info* process = get_process_info(OSMP_rank);
+    int index = 0;
+    int expected = 0;
+    while(index < RENDEZVOUS_DESCRIPTORS &&
+          !__atomic_compare_exchange_n(&process->rendezvous[index].in_use, &expected, 1, 0,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        expected = 0;
+        index++;
+    }
+    if(index == RENDEZVOUS_DESCRIPTORS) {
+        return OSMP_FAILURE;
+    }
+
+    rendezvous_descriptor* descriptor = &process->rendezvous[index];
+    descriptor->len = length_in_bytes;
+    descriptor->type = datatype;
+    descriptor->tag = tag;
+    descriptor->status = RENDEZVOUS_PENDING;
+    descriptor->address = (uint64_t)(uintptr_t)buf;
+
+    wait_until_available(dest);
+    postbox_enqueue(dest, RENDEZVOUS_MESSAGE(shm_ptr->max_slots, OSMP_rank, index));
+    osmp_sem_wait(&descriptor->sem_done);
+
+    int status = __atomic_load_n(&descriptor->status, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&descriptor->in_use, 0, __ATOMIC_RELEASE);
+    if(status == RENDEZVOUS_REJECTED) {
+        // Ohne Zugriff auf den Adressraum wird jede weitere Rendezvous-Sendung ebenfalls abgelehnt
+        log_to_file(2, "Rendezvous rejected, falling back to message slots.\n");
+        __atomic_store_n(&rendezvous_disabled, 1, __ATOMIC_RELAXED);
+        return OSMP_FAILURE;
+    }
+    return OSMP_SUCCESS;
+}
+
+/**
+ * Liest eine Rendezvous-Nachricht aus dem Adressraum des Senders und meldet dem Sender das Ergebnis.
+ * @param descriptor Deskriptor der Nachricht.
+ * @param source     Rang des Senders.
+ * @param buf        Zielpuffer (darf NULL sein, wenn capacity 0 ist).
+ * @param capacity   Größe des Zielpuffers in Bytes; darüber hinausgehende Bytes werden verworfen.
+ * @return OSMP_SUCCESS, wenn die Nachricht gelesen oder verworfen wurde; OSMP_FAILURE, wenn der Zugriff auf den
+ * Adressraum des Senders scheiterte. Der Sender schickt die Nachricht dann erneut über einen Nachrichtenslot.
+ */
+int consume_rendezvous(rendezvous_descriptor* descriptor, int source, void *buf, int capacity) {
+    log_osmp_lib_call("consume_rendezvous");
+    int to_copy = descriptor->len < capacity ? descriptor->len : capacity;
+    int status = RENDEZVOUS_DONE;
+
+    // process_vm_readv() kann weniger Bytes liefern als angefordert
+    char* target = buf;
+    int copied = 0;
+    while(copied < to_copy) {
+        struct iovec local = {target + copied, (size_t)(to_copy - copied)};
+        struct iovec remote = {(void*)(uintptr_t)(descriptor->address + (uint64_t)copied), (size_t)(to_copy - copied)};
+        ssize_t result = process_vm_readv(get_process_info(source)->pid, &local, 1, &remote, 1, 0);
+        if(result <= 0) {
+            log_to_file(3, "process_vm_readv failed, rejecting rendezvous.\n");
+            status = RENDEZVOUS_REJECTED;
+            break;
+        }
+        copied += (int)result;
+    }
+
+    __atomic_store_n(&descriptor->status, status, __ATOMIC_RELEASE);
+    osmp_sem_post(&descriptor->sem_done);
+    return status == RENDEZVOUS_DONE ? OSMP_SUCCESS : OSMP_FAILURE;
+}
+
+/**
+ * Sendet eine Nachricht, die größer als die maximale Nutzlast ist. Der Nachrichtenslot wird sofort im Postfach des
+ * Empfängers abgelegt; anschließend wird die Nachricht in Teilstücken von get_chunk_length() Bytes durch den Heap-Block
+ * des Slots übertragen, die der Empfänger schon liest, während der Sender die folgenden Teilstücke füllt. Blockiert, bis
+ * alle Teilstücke kopiert wurden.
+ * @param buf             Startadresse der Nachricht.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param datatype        OSMP-Typ der Nachricht.
+ * @param dest            Rang des Empfängers.
+ * @param tag             Tag der Nachricht.
+ */
+void send_chunked(const void *buf, int length_in_bytes, OSMP_Datatype datatype, int dest, int tag) {
+    log_osmp_lib_call("send_chunked");
+    int slot_index = acquire_slot(dest, length_in_bytes, datatype, tag);
+    commit_slot(slot_index);
+
+    // Der Empfänger gibt den Slot erst nach dem letzten Teilstück frei
+    message_slot* slot = get_slot(slot_index);
+    char* ring = get_slot_payload(slot_index);
+    const char* source = buf;
+    int max_chunk_length = get_chunk_length();
+    for(int offset = 0, chunk = 0; offset < length_in_bytes; offset += max_chunk_length, chunk++) {
+        int chunk_length = length_in_bytes - offset < max_chunk_length ? length_in_bytes - offset : max_chunk_length;
+
+        osmp_sem_wait(&slot->sem_chunks_empty);
+        memcpy(ring + (chunk % CHUNK_DEPTH) * max_chunk_length, source + offset, (size_t)chunk_length);
+        osmp_sem_post(&slot->sem_chunks_full);
+    }
+}
+
+/**
+ * Kopiert die Nutzlast eines empfangenen Nachrichtenslots in einen Puffer, ohne den Slot freizugeben. Nachrichten
+ * oberhalb der maximalen Nutzlast werden Teilstück für Teilstück gelesen, während der Sender noch schreibt.
+ * @param slot_index Index des Nachrichtenslots.
+ * @param buf        Zielpuffer (darf NULL sein, wenn capacity 0 ist).
+ * @param capacity   Größe des Zielpuffers in Bytes; darüber hinausgehende Bytes werden verworfen.
+ */
+void read_slot(int slot_index, void *buf, int capacity) {
+    message_slot* slot = get_slot(slot_index);
+    char* target = buf;
+
+    if(slot->len <= shm_ptr->max_payload_length) {
+        int to_copy = slot->len < capacity ? slot->len : capacity;
+        memcpy(target, get_slot_payload(slot_index), (unsigned long) to_copy);
+    } else {
+        char* ring = get_slot_payload(slot_index);
+        int max_chunk_length = get_chunk_length();
+        for(int offset = 0, chunk = 0; offset < slot->len; offset += max_chunk_length, chunk++) {
+            int chunk_length = slot->len - offset < max_chunk_length ? slot->len - offset : max_chunk_length;
+
+            osmp_sem_wait(&slot->sem_chunks_full);
+            if(offset < capacity) {
+                int to_copy = capacity - offset < chunk_length ? capacity - offset : chunk_length;
+                memcpy(target + offset, ring + (chunk % CHUNK_DEPTH) * max_chunk_length, (size_t)to_copy);
+            }
+            osmp_sem_post(&slot->sem_chunks_empty);
+        }
+    }
+}
+
+/**
+ * Kopiert eine empfangene Nachricht in einen Puffer und gibt ihren Nachrichtenslot frei. Nachrichten oberhalb der
+ * maximalen Nutzlast werden Teilstück für Teilstück gelesen, während der Sender noch schreibt;
+ * Rendezvous-Nachrichten werden direkt aus dem Adressraum des Senders gelesen.
+ * @param slot_index Wert aus dem Postfach (Index des Nachrichtenslots, Rendezvous-Deskriptor oder Inline-Nachricht).
+ * @param buf        Zielpuffer (darf NULL sein, wenn capacity 0 ist).
+ * @param capacity   Größe des Zielpuffers in Bytes; darüber hinausgehende Bytes werden verworfen.
+ * @return OSMP_SUCCESS, wenn die Nachricht gelesen wurde; OSMP_FAILURE, wenn der Sender eine abgelehnte
+ * Rendezvous-Nachricht erneut senden muss und der Empfänger auf die nächste Nachricht warten soll.
+ */
+int consume_message(int slot_index, void *buf, int capacity) {
+    log_osmp_lib_call("consume_message");
+    rendezvous_descriptor* descriptor = get_rendezvous(slot_index);
+    if(descriptor != NULL) {
+        return consume_rendezvous(descriptor, get_message_source(slot_index), buf, capacity);
+    }
+    if(slot_index >= get_inline_base()) {
+        read_inline_message(slot_index, buf, capacity);
+        return OSMP_SUCCESS;
+    }
+
+    read_slot(slot_index, buf, capacity);
+    release_slot(slot_index);
+    return OSMP_SUCCESS;
+}
+
+int OSMP_Send(const void *buf, int count, OSMP_Datatype datatype, int dest) {
+    log_osmp_lib_call("OSMP_Send");
+    return OSMP_SendTag(buf, count, datatype, dest, 0);
+}
+
+/**
+ * Schreibt eine Nachricht per process_vm_writev() in den Adressraum eines anderen Prozesses.
+ * @param pid             PID des Empfängers.
+ * @param address         Zieladresse im Adressraum des Empfängers.
+ * @param buf             Nutzlast der Nachricht.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @return OSMP_SUCCESS, wenn die ganze Nachricht geschrieben wurde, sonst OSMP_FAILURE.
+ */
+int write_remote(int pid, uint64_t address, const void *buf, int length_in_bytes) {
+    // process_vm_writev() kann weniger Bytes schreiben als angefordert
+    const char* source = buf;
+    int copied = 0;
+    while(copied < length_in_bytes) {
+        struct iovec local = {(void*)(source + copied), (size_t)(length_in_bytes - copied)};
+        struct iovec remote = {(void*)(uintptr_t)(address + (uint64_t)copied), (size_t)(length_in_bytes - copied)};
+        ssize_t result = process_vm_writev(pid, &local, 1, &remote, 1, 0);
+        if(result <= 0) {
+            return OSMP_FAILURE;
+        }
+        copied += (int)result;
+    }
+    return OSMP_SUCCESS;
+}
+
+/**
+ * Schreibt eine Nachricht direkt in den Empfangspuffer, den der Empfänger für sein nächstes OSMP_IRecv() bereitgestellt
+ * hat, und legt nur einen DIRECT_ENTRY ins Postfach. Blockiert nicht: Ist kein passender Puffer bereitgestellt, liegt
+ * noch eine ältere Nachricht im Postfach oder ist das Postfach voll, muss der Aufrufer den üblichen Weg nehmen.
+ * @param buf             Nutzlast der Nachricht.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param dest            Rang des Empfängers.
+ * @param tag             Tag der Nachricht.
+ * @return OSMP_SUCCESS, wenn die Nachricht zugestellt wurde, sonst OSMP_FAILURE.
+ */
+int try_send_direct(const void *buf, int length_in_bytes, int dest, int tag) {
+    process_info* receiver = get_process_info(dest);
+    posted_receive* posted = &receiver->posted;
+    int expected = POSTED_OPEN;
+    if(__atomic_load_n(&direct_disabled, __ATOMIC_RELAXED)
+       || __atomic_load_n(&posted->state, __ATOMIC_RELAXED) != POSTED_OPEN
+       || !__atomic_compare_exchange_n(&posted->state, &expected, POSTED_CLAIMED, 0,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        return OSMP_FAILURE;
+    }
+    if(posted->capacity < length_in_bytes || osmp_sem_trywait(&receiver->postbox.sem_proc_empty) != OSMP_SUCCESS) {
+        __atomic_store_n(&posted->state, POSTED_OPEN, __ATOMIC_RELEASE);
+        return OSMP_FAILURE;
+    }
+
+    // Solange der Puffer belegt ist, entnimmt der Empfänger nichts; eine ältere Nachricht im Postfach hat Vorrang
+    postbox_utilities* postbox = &receiver->postbox;
+    int result = OSMP_FAILURE;
+    if(__atomic_load_n(&postbox->in_index, __ATOMIC_SEQ_CST) == __atomic_load_n(&postbox->out_index, __ATOMIC_SEQ_CST)) {
+        if(dest == OSMP_rank) {
+            memcpy((void*)(uintptr_t)posted->address, buf, (size_t)length_in_bytes);
+            result = OSMP_SUCCESS;
+        } else {
+            result = write_remote(receiver->pid, posted->address, buf, length_in_bytes);
+            if(result != OSMP_SUCCESS) {
+                // Ohne Zugriff auf den Adressraum des Empfängers wird jeder weitere Versuch ebenfalls scheitern
+                log_to_file(2, "process_vm_writev failed, falling back to message slots.\n");
+                __atomic_store_n(&direct_disabled, 1, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    if(result != OSMP_SUCCESS) {
+        osmp_sem_post(&postbox->sem_proc_empty);
+        __atomic_store_n(&posted->state, POSTED_OPEN, __ATOMIC_RELEASE);
+        return OSMP_FAILURE;
+    }
+
+    posted->source = OSMP_rank;
+    posted->tag = tag;
+    posted->len = length_in_bytes;
+    __atomic_store_n(&posted->state, POSTED_FILLED, __ATOMIC_RELEASE);
+    postbox_put(dest, DIRECT_ENTRY);
+    return OSMP_SUCCESS;
+}
+
+/**
+ * Sendet eine Nachricht, deren Argumente bereits geprüft wurden, auf dem zu ihrer Länge passenden Weg.
+ * @param buf             Nutzlast der Nachricht.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param datatype        OSMP-Typ der Nachricht.
+ * @param dest            Rang des Empfängers.
+ * @param tag             Tag der Nachricht.
+ */
+void send_bytes(const void *buf, int length_in_bytes, OSMP_Datatype datatype, int dest, int tag) {
+    log_osmp_lib_call("send_bytes");
+    if(length_in_bytes <= INLINE_PAYLOAD_LENGTH) {
+        // Kleine Nachrichten brauchen weder Nachrichtenslot noch Heap-Block
+        wait_until_available(dest);
+        postbox_enqueue_inline(dest, buf, length_in_bytes, tag);
+        return;
+    }
+    if(try_send_direct(buf, length_in_bytes, dest, tag) == OSMP_SUCCESS) {
+        return;
+    }
+    // Wie das Senden in Teilstücken wartet eine Rendezvous-Sendung auf den Empfänger und ersetzt es daher nur dort
+    if(length_in_bytes > shm_ptr->max_payload_length && length_in_bytes >= RENDEZVOUS_THRESHOLD &&
+       send_rendezvous(buf, length_in_bytes, datatype, dest, tag) == OSMP_SUCCESS) {
+        return;
+    }
+    if(length_in_bytes > shm_ptr->max_payload_length) {
+        send_chunked(buf, length_in_bytes, datatype, dest, tag);
+        return;
+    }
+
+    int slot_index = acquire_slot(dest, length_in_bytes, datatype, tag);
 
     // Schreibe Nachricht in Slot
-    mempcpy(&shm_ptr->slots[slot_index].payload, buf, (unsigned int)length_in_bytes);
-    shm_ptr->slots[slot_index].len = length_in_bytes;
-    shm_ptr->slots[slot_index].from = OSMP_rank;
+    memcpy(get_slot_payload(slot_index), buf, (unsigned int)length_in_bytes);
+
+    commit_slot(slot_index);
+}
+
+/**
+ * Liefert, ob eine Nachricht nur blockierend gesendet werden kann, weil sie in Teilstücken oder per Rendezvous
+ * übertragen wird und damit auf den Empfänger wartet.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @return 1, wenn das Senden auf den Empfänger warten muss, sonst 0.
+ */
+int send_may_block(int length_in_bytes) {
+    return length_in_bytes > INLINE_PAYLOAD_LENGTH && length_in_bytes > shm_ptr->max_payload_length;
+}
+
+/**
+ * Versucht, eine Nachricht zu senden, ohne zu blockieren. Das gelingt für Nachrichten, die inline oder in einem
+ * Nachrichtenslot verschickt werden, solange der Empfänger erreichbar ist und im Postfach sowie bei Bedarf im Vorrat
+ * der Nachrichtenslots und in der Größenklasse des Heaps Platz ist.
+ * @param buf             Nutzlast der Nachricht.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param datatype        OSMP-Typ der Nachricht.
+ * @param dest            Rang des Empfängers.
+ * @param tag             Tag der Nachricht.
+ * @return OSMP_SUCCESS, wenn die Nachricht im Postfach liegt; OSMP_FAILURE, wenn das Senden blockieren würde.
+ */
+int try_send_bytes(const void *buf, int length_in_bytes, OSMP_Datatype datatype, int dest, int tag) {
+    process_info* receiver = get_process_info(dest);
+    int is_inline = length_in_bytes <= INLINE_PAYLOAD_LENGTH;
+    if(!is_inline && try_send_direct(buf, length_in_bytes, dest, tag) == OSMP_SUCCESS) {
+        return OSMP_SUCCESS;
+    }
+    if(send_may_block(length_in_bytes)) {
+        return OSMP_FAILURE;
+    }
+    if(__atomic_load_n(&receiver->available, __ATOMIC_ACQUIRE) == NOT_AVAILABLE
+       || osmp_sem_trywait(&receiver->postbox.sem_proc_empty) != OSMP_SUCCESS) {
+        return OSMP_FAILURE;
+    }
+    if(is_inline) {
+        postbox_put_inline(dest, buf, length_in_bytes, tag);
+        return OSMP_SUCCESS;
+    }
+
+    int reserved;
+    if(try_take_slot_credits(1, &reserved) == 0) {
+        // Der Eintrag wurde nur gezählt, aber nicht belegt und kann zurückgegeben werden
+        osmp_sem_post(&receiver->postbox.sem_proc_empty);
+        return OSMP_FAILURE;
+    }
+    int slot_index = try_claim_slot(reserved, dest, length_in_bytes, datatype, tag);
+    if(slot_index == NO_SLOT) {
+        // Ohne freien Heap-Block gehen Berechtigung und Eintrag zurück, damit der Aufrufer nicht blockiert
+        osmp_sem_post(get_credit_semaphore(reserved ? OSMP_rank : SHARED_CREDIT));
+        osmp_sem_post(&receiver->postbox.sem_proc_empty);
+        return OSMP_FAILURE;
+    }
+    memcpy(get_slot_payload(slot_index), buf, (size_t)length_in_bytes);
+    postbox_put(dest, slot_index);
+    return OSMP_SUCCESS;
+}
+
+int OSMP_SendTag(const void *buf, int count, OSMP_Datatype datatype, int dest, int tag) {
+    log_osmp_lib_call("OSMP_SendTag");
+    if(tag < 0) {
+        log_to_file(2, "Tag must not be negative.\n");
+        return OSMP_FAILURE;
+    }
+    if(count <= 0) {
+        log_to_file(2, "Cant send with count zero or less.\n");
+        return OSMP_FAILURE;
+    }
+    if(dest>=OSMP_size || dest<0){
+        log_to_file(2, "Destination must be between zero and OSMP_size.\n");
+        return OSMP_FAILURE;
+    }
+    unsigned int datatype_size;
+    OSMP_SizeOf(datatype, &datatype_size);
+    send_bytes(buf, (int)datatype_size * count, datatype, dest, tag);
+    return OSMP_SUCCESS;
+}
+
+/**
+ * Sendet einen Lauf von Nachrichten, die jeweils in einen Nachrichtenslot passen, an den angegebenen Prozess.
+ * Nachrichtenslots werden gemeinsam reserviert und gemeinsam in das Postfach gestellt; reichen die freien Slots nicht
+ * für alle Nachrichten, werden die reservierten zuerst versendet, damit der Empfänger Slots freigeben kann.
+ * @param msgs    Nachrichtenbeschreibungen des Laufs.
+ * @param lengths Längen der Nachrichten in Bytes.
+ * @param n       Anzahl der Nachrichten.
+ * @param dest    Rang des Empfängers.
+ * @param slots   Feld für die Indizes der reservierten Nachrichtenslots (mindestens n Einträge).
+ */
+void send_batch_run(const OSMP_Msg *msgs, const int *lengths, int n, int dest, int *slots) {
+    log_osmp_lib_call("send_batch_run");
+    int depth = shm_ptr->max_messages_proc;
+
+    int sent = 0;
+    while(sent < n) {
+        int wanted = n - sent < depth ? n - sent : depth;
+        int from_reservation;
+        int reserved = take_slot_credits(wanted, &from_reservation);
+        tagged_stack_pop_many(&shm_ptr->free_slots, get_next_free_slots(), reserved, slots);
+
+        for(int i = 0; i < reserved; i++) {
+            const OSMP_Msg* msg = &msgs[sent + i];
+            get_slot(slots[i])->credit_owner = i < from_reservation ? OSMP_rank : SHARED_CREDIT;
+            fill_slot(slots[i], dest, lengths[sent + i], msg->datatype, msg->tag);
+            memcpy(get_slot_payload(slots[i]), msg->buf, (size_t)lengths[sent + i]);
+        }
+        postbox_enqueue_many(dest, slots, reserved);
+        sent += reserved;
+    }
+}
+
+/**
+ * Sendet einen Lauf von Nachrichten bis INLINE_PAYLOAD_LENGTH Bytes direkt über das Postfach des angegebenen
+ * Prozesses. Die Einträge werden wie bei postbox_enqueue_many() gemeinsam reserviert und veröffentlicht.
+ * @param msgs    Nachrichtenbeschreibungen des Laufs.
+ * @param lengths Längen der Nachrichten in Bytes.
+ * @param n       Anzahl der Nachrichten.
+ * @param dest    Rang des Empfängers.
+ */
+void send_inline_run(const OSMP_Msg *msgs, const int *lengths, int n, int dest) {
+    log_osmp_lib_call("send_inline_run");
+    postbox_utilities* postbox = &get_process_info(dest)->postbox;
+    int sent = 0;
+    while(sent < n) {
+        int reserved = osmp_sem_wait_many(&postbox->sem_proc_empty, n - sent);
+
+        uint64_t position = __atomic_fetch_add(&postbox->in_index, (uint64_t)reserved, __ATOMIC_RELAXED);
+        for(int i = 0; i < reserved; i++, position++) {
+            postbox_entry* entry = postbox_claim(dest, position);
+            fill_inline_entry(entry, msgs[sent + i].buf, lengths[sent + i], msgs[sent + i].tag);
+            postbox_publish(entry, position);
+        }
+
+        osmp_sem_post_many(&postbox->sem_proc_full, reserved);
+        signal_event(dest);
+        sent += reserved;
+    }
+}
+
+/**
+ * Ordnet eine Nachricht eines Stapels ihrer Versandart zu. Aufeinanderfolgende Nachrichten derselben Art werden
+ * gemeinsam versendet.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @param batch_limit     Größte Länge, die gemeinsam über Nachrichtenslots versendet wird.
+ * @return 0 für Inline-Nachrichten, 1 für Nachrichten in einem Nachrichtenslot, 2 für einzeln versendete Nachrichten.
+ */
+int get_batch_kind(int length_in_bytes, int batch_limit) {
+    if(length_in_bytes <= INLINE_PAYLOAD_LENGTH) {
+        return 0;
+    }
+    return length_in_bytes <= batch_limit ? 1 : 2;
+}
+
+int OSMP_SendBatch(const OSMP_Msg *msgs, int n, int dest) {
+    log_osmp_lib_call("OSMP_SendBatch");
+    if(msgs == NULL || n <= 0) {
+        log_to_file(2, "Cant send a batch without messages.\n");
+        return OSMP_FAILURE;
+    }
+    if(dest>=OSMP_size || dest<0){
+        log_to_file(2, "Destination must be between zero and OSMP_size.\n");
+        return OSMP_FAILURE;
+    }
 
-    pthread_mutex_lock(&process_info->postbox.mutex_proc_in);
+    // Alle Beschreibungen vor dem Senden prüfen, damit ein ungültiger Stapel nicht teilweise versendet wird. Hinter
+    // den Längen liegt Platz für die Indizes der reservierten Nachrichtenslots.
+    int* lengths = malloc(2 * sizeof(int) * (size_t)n);
+    if(lengths == NULL) {
+        log_to_file(3, "Failed to allocate memory for the batch.\n");
+        return OSMP_FAILURE;
+    }
+    for(int i = 0; i < n; i++) {
+        unsigned int datatype_size;
+        if(msgs[i].count <= 0 || msgs[i].tag < 0 || OSMP_SizeOf(msgs[i].datatype, &datatype_size) != OSMP_SUCCESS) {
+            log_to_file(2, "Invalid message in batch.\n");
+            free(lengths);
+            return OSMP_FAILURE;
+        }
+        lengths[i] = (int)datatype_size * msgs[i].count;
+    }
+
+    // Nachrichten, die nicht in einen Nachrichtenslot passen, profitieren nicht vom gemeinsamen Reservieren
+    int batch_limit = shm_ptr->max_payload_length;
+
+    wait_until_available(dest);
+    int first = 0;
+    while(first < n) {
+        int kind = get_batch_kind(lengths[first], batch_limit);
+        if(kind == 2) {
+            OSMP_SendTag(msgs[first].buf, msgs[first].count, msgs[first].datatype, dest, msgs[first].tag);
+            first++;
+            continue;
+        }
+        int last = first;
+        while(last < n && get_batch_kind(lengths[last], batch_limit) == kind) {
+            last++;
+        }
+        if(kind == 0) {
+            send_inline_run(&msgs[first], &lengths[first], last - first, dest);
+        } else {
+            send_batch_run(&msgs[first], &lengths[first], last - first, dest, lengths + n);
+        }
+        first = last;
+    }
+    free(lengths);
+    return OSMP_SUCCESS;
+}
 
-    int process_in_index = process_info->postbox.in_index;
-    process_info->postbox.postbox[process_in_index] = slot_index;
-    ++process_in_index;
-    if (process_in_index==OSMP_MAX_MESSAGES_PROC){
-        process_in_index=0;
+int OSMP_SendAlloc(int dest, int len, void **ptr) {
+    log_osmp_lib_call("OSMP_SendAlloc");
+    if(ptr == NULL) {
+        log_to_file(2, "Pointer for the payload was null.\n");
+        return OSMP_FAILURE;
+    }
+    if(len <= 0) {
+        log_to_file(2, "Cant send with length zero or less.\n");
+        return OSMP_FAILURE;
+    }
+    if(dest>=OSMP_size || dest<0){
+        log_to_file(2, "Destination must be between zero and OSMP_size.\n");
+        return OSMP_FAILURE;
+    }
+    if(len > shm_ptr->max_payload_length) {
+        log_to_file(2, "Cant send more than the maximum payload length.\n");
+        return OSMP_FAILURE;
     }
-    process_info->postbox.in_index = process_in_index;
 
-    pthread_mutex_lock(&(process_info->postbox.sem_proc_full_value_mutex));
-    process_info->postbox.sem_proc_full_value++;
-    pthread_mutex_unlock(&(process_info->postbox.sem_proc_full_value_mutex));
+    int slot_index = acquire_slot(dest, len, OSMP_BYTE, 0);
+    message_slot* slot = get_slot(slot_index);
+    __atomic_store_n(&get_heap_owner(slot->heap_class)[slot->block], BLOCK_OWNER(slot_index, BLOCK_SEND_ALLOCATED),
+                     __ATOMIC_RELEASE);
+    *ptr = get_slot_payload(slot_index);
+    return OSMP_SUCCESS;
+}
 
-    pthread_mutex_unlock(&process_info->postbox.mutex_proc_in);
+int OSMP_SendCommit(void *ptr) {
+    log_osmp_lib_call("OSMP_SendCommit");
+    // Nur ein mit OSMP_SendAlloc() reservierter und noch nicht versendeter Block darf veröffentlicht werden
+    int slot_index = change_block_state(ptr, BLOCK_SEND_ALLOCATED, BLOCK_QUEUED);
+    if(slot_index == NO_SLOT) {
+        log_to_file(2, "Pointer doesn't belong to a message slot reserved with OSMP_SendAlloc.\n");
+        return OSMP_FAILURE;
+    }
+    commit_slot(slot_index);
+    return OSMP_SUCCESS;
+}
 
-    sem_post(&process_info->postbox.sem_proc_full);
+/**
+ * Prüft die Suchkriterien von OSMP_RecvFrom(), OSMP_Probe() und OSMP_Iprobe().
+ * @param source Gesuchter Sender oder OSMP_ANY_SOURCE.
+ * @param tag    Gesuchtes Tag oder OSMP_ANY_TAG.
+ * @return OSMP_SUCCESS, wenn die Kriterien gültig sind, sonst OSMP_FAILURE.
+ */
+int check_match_arguments(int source, int tag) {
+    if(source != OSMP_ANY_SOURCE && (source >= OSMP_size || source < 0)) {
+        log_to_file(2, "Source must be between zero and OSMP_size or OSMP_ANY_SOURCE.\n");
+        return OSMP_FAILURE;
+    }
+    if(tag != OSMP_ANY_TAG && tag < 0) {
+        log_to_file(2, "Tag must not be negative unless it is OSMP_ANY_TAG.\n");
+        return OSMP_FAILURE;
+    }
     return OSMP_SUCCESS;
 }
 
 int OSMP_Recv(void *buf, int count, OSMP_Datatype datatype, int *source, int *len) {
     log_osmp_lib_call("OSMP_Recv");
+    int tag;
+    return OSMP_RecvFrom(buf, count, datatype, OSMP_ANY_SOURCE, OSMP_ANY_TAG, source, &tag, len);
+}
+
+/**
+ * Empfängt die älteste Nachricht, die zu den bereits geprüften Suchkriterien passt.
+ * @param buf           Zielpuffer.
+ * @param capacity      Größe des Zielpuffers in Bytes; darüber hinausgehende Bytes werden verworfen.
+ * @param source        Gesuchter Sender oder OSMP_ANY_SOURCE.
+ * @param tag           Gesuchtes Tag oder OSMP_ANY_TAG.
+ * @param actual_source Rang des tatsächlichen Senders.
+ * @param actual_tag    Tag der empfangenen Nachricht.
+ * @param len           Tatsächliche Länge der Nachricht in Bytes.
+ * @return OSMP_SUCCESS oder OSMP_FAILURE, wenn der Zwischenspeicher für Inline-Nachrichten erschöpft ist.
+ */
+int receive_bytes(void *buf, int capacity, int source, int tag, int *actual_source, int *actual_tag, int *len) {
+    log_osmp_lib_call("receive_bytes");
+    // Eine abgelehnte Rendezvous-Nachricht sendet der Sender erneut über einen Nachrichtenslot
+    int slot_index;
+    do {
+        slot_index = find_matching_message(source, tag, 1);
+        if(slot_index == INLINE_EXHAUSTED) {
+            return OSMP_FAILURE;
+        }
+        *actual_source = get_message_source(slot_index);
+        *actual_tag = get_message_tag(slot_index);
+        *len = get_message_length(slot_index);
+        if(capacity < *len) {
+            log_to_file(3, "Recv buffer too small!\n");
+        }
+    } while(consume_message(slot_index, buf, capacity) != OSMP_SUCCESS);
+    return OSMP_SUCCESS;
+}
+
+int OSMP_RecvFrom(void *buf, int count, OSMP_Datatype datatype, int source, int tag, int *actual_source,
+                  int *actual_tag, int *len) {
+    log_osmp_lib_call("OSMP_RecvFrom");
+    if(check_match_arguments(source, tag) != OSMP_SUCCESS) {
+        return OSMP_FAILURE;
+    }
     if(count <= 0) {
         log_to_file(2, "Cant receive with count zero or less.\n");
         return OSMP_FAILURE;
@@ -427,73 +2271,696 @@ int OSMP_Recv(void *buf, int count, OSMP_Datatype datatype, int *source, int *le
 
     unsigned int datatype_size;
     OSMP_SizeOf(datatype, &datatype_size);
-    int length_in_bytes = (int)datatype_size * count;
+    return receive_bytes(buf, (int)datatype_size * count, source, tag, actual_source, actual_tag, len);
+}
+
+int OSMP_Probe(int source, int tag, int *actual_source, int *actual_tag, int *len) {
+    log_osmp_lib_call("OSMP_Probe");
+    if(check_match_arguments(source, tag) != OSMP_SUCCESS) {
+        return OSMP_FAILURE;
+    }
+
+    // Die Nachricht bleibt in der Verwaltung und wird von einem späteren Empfangsaufruf abgeholt
+    int message = find_matching_message(source, tag, 0);
+    if(message == INLINE_EXHAUSTED) {
+        return OSMP_FAILURE;
+    }
+    *actual_source = get_message_source(message);
+    *actual_tag = get_message_tag(message);
+    *len = get_message_length(message);
+    return OSMP_SUCCESS;
+}
+
+int OSMP_Iprobe(int source, int tag, int *flag, int *actual_source, int *actual_tag, int *len) {
+    log_osmp_lib_call("OSMP_Iprobe");
+    if(check_match_arguments(source, tag) != OSMP_SUCCESS) {
+        return OSMP_FAILURE;
+    }
+
+    int message = try_find_matching_message(source, tag, 0);
+    if(message == NO_MESSAGE) {
+        *flag = 0;
+        return OSMP_SUCCESS;
+    }
+    *flag = 1;
+    *actual_source = get_message_source(message);
+    *actual_tag = get_message_tag(message);
+    *len = get_message_length(message);
+    return OSMP_SUCCESS;
+}
+
+int OSMP_RecvBorrow(void **ptr, int *len, int *source) {
+    log_osmp_lib_call("OSMP_RecvBorrow");
+    if(ptr == NULL || len == NULL || source == NULL) {
+        log_to_file(2, "Output parameters of OSMP_RecvBorrow must not be null.\n");
+        return OSMP_FAILURE;
+    }
+
+    int slot_index;
+    borrowed_buffer * node;
+    void * buffer;
+    do {
+        slot_index = find_matching_message(OSMP_ANY_SOURCE, OSMP_ANY_TAG, 1);
+        if(slot_index == INLINE_EXHAUSTED) {
+            return OSMP_FAILURE;
+        }
+        *len = get_message_length(slot_index);
+        *source = get_message_source(slot_index);
+
+        if(slot_index < shm_ptr->max_slots && *len <= shm_ptr->max_payload_length) {
+            // Der Slot bleibt bis OSMP_RecvRelease() reserviert
+            message_slot* slot = get_slot(slot_index);
+            __atomic_store_n(&get_heap_owner(slot->heap_class)[slot->block], BLOCK_OWNER(slot_index, BLOCK_BORROWED),
+                             __ATOMIC_RELEASE);
+            *ptr = get_slot_payload(slot_index);
+            return OSMP_SUCCESS;
+        }
+
+        // Große und Rendezvous-Nachrichten liegen nicht zusammenhängend im Shared Memory und werden wie Inline-Nachrichten
+        // in einen privaten Puffer kopiert
+        node = malloc(sizeof(borrowed_buffer));
+        buffer = malloc((size_t) *len);
+        if(node == NULL || buffer == NULL) {
+            log_to_file(3, "Failed to allocate memory for a borrowed message.\n");
+            consume_message(slot_index, NULL, 0);
+            free(node);
+            free(buffer);
+            return OSMP_FAILURE;
+        }
+        if(consume_message(slot_index, buffer, *len) == OSMP_SUCCESS) {
+            break;
+        }
+        free(node);
+        free(buffer);
+    } while(1);
+
+    node->buffer = buffer;
+    pthread_mutex_lock(&borrowed_buffers_mutex);
+    node->next = borrowed_buffers;
+    borrowed_buffers = node;
+    pthread_mutex_unlock(&borrowed_buffers_mutex);
+
+    *ptr = buffer;
+    return OSMP_SUCCESS;
+}
+
+/**
+ * Gibt einen privaten Puffer frei, in den OSMP_RecvBorrow() eine große Nachricht zusammengesetzt hat.
+ * @param ptr Zeiger, den OSMP_RecvBorrow() geliefert hat.
+ * @return OSMP_SUCCESS, wenn der Puffer gefunden und freigegeben wurde, sonst OSMP_FAILURE.
+ */
+int release_borrowed_buffer(void *ptr) {
+    pthread_mutex_lock(&borrowed_buffers_mutex);
+    borrowed_buffer ** iterator = &borrowed_buffers;
+    while(*iterator != NULL && (*iterator)->buffer != ptr) {
+        iterator = &((*iterator)->next);
+    }
+    borrowed_buffer * node = *iterator;
+    if(node != NULL) {
+        *iterator = node->next;
+    }
+    pthread_mutex_unlock(&borrowed_buffers_mutex);
+
+    if(node == NULL) {
+        return OSMP_FAILURE;
+    }
+    free(node->buffer);
+    free(node);
+    return OSMP_SUCCESS;
+}
+
+int OSMP_RecvRelease(void *ptr) {
+    log_osmp_lib_call("OSMP_RecvRelease");
+    if(get_slot_index(ptr) == NO_SLOT && release_borrowed_buffer(ptr) == OSMP_SUCCESS) {
+        return OSMP_SUCCESS;
+    }
+    // Nur ein von OSMP_RecvBorrow() geliehener Block darf freigegeben werden
+    int slot_index = change_block_state(ptr, BLOCK_BORROWED, BLOCK_QUEUED);
+    if(slot_index == NO_SLOT) {
+        log_to_file(2, "Pointer doesn't belong to a message slot borrowed with OSMP_RecvBorrow.\n");
+        return OSMP_FAILURE;
+    }
+    release_slot(slot_index);
+    return OSMP_SUCCESS;
+}
+
+/**
+ * Empfängt ohne zu blockieren alle vorliegenden Nachrichten, höchstens aber max, in Ankunftsreihenfolge. Die Slots der
+ * gelesenen Nachrichten werden am Ende gemeinsam freigegeben. Abgelehnte Rendezvous-Nachrichten werden übersprungen,
+ * da der Sender sie erneut sendet.
+ * @param bufs     Feld mit max Zielpuffern oder NULL, um die Nachrichten zu verwerfen.
+ * @param capacity Größe jedes Zielpuffers in Bytes.
+ * @param max      Höchstzahl der zu empfangenden Nachrichten.
+ * @param sources  Feld für die Ränge der Sender oder NULL.
+ * @param lens     Feld für die Längen der Nachrichten in Bytes oder NULL.
+ * @param got      Anzahl der empfangenen Nachrichten.
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int receive_queued(void **bufs, int capacity, int max, int *sources, int *lens, int *got) {
+    log_osmp_lib_call("receive_queued");
+    *got = 0;
+    int* messages = malloc(sizeof(int) * (size_t)max);
+    if(messages == NULL) {
+        log_to_file(3, "Failed to allocate memory for received messages.\n");
+        return OSMP_FAILURE;
+    }
+    int count = take_queued_messages(messages, max);
+
+    // Gelesene Slot-Indizes werden vorne in messages gesammelt; sie überholen nie den aktuellen Eintrag
+    int slots = 0;
+    for(int i = 0; i < count; i++) {
+        int message = messages[i];
+        void* buf = bufs != NULL ? bufs[*got] : NULL;
+        int source = get_message_source(message);
+        int len = get_message_length(message);
+
+        rendezvous_descriptor* descriptor = get_rendezvous(message);
+        if(descriptor != NULL) {
+            if(consume_rendezvous(descriptor, source, buf, bufs != NULL ? capacity : 0) != OSMP_SUCCESS) {
+                continue;
+            }
+        } else if(message >= get_inline_base()) {
+            read_inline_message(message, buf, bufs != NULL ? capacity : 0);
+        } else {
+            read_slot(message, buf, bufs != NULL ? capacity : 0);
+            messages[slots++] = message;
+        }
+        if(sources != NULL) {
+            sources[*got] = source;
+        }
+        if(lens != NULL) {
+            lens[*got] = len;
+        }
+        (*got)++;
+    }
+    release_slots(messages, slots);
+    free(messages);
+    return OSMP_SUCCESS;
+}
+
+int OSMP_RecvMany(void **bufs, int count, OSMP_Datatype datatype, int maxn, int *got, int *sources, int *lens) {
+    log_osmp_lib_call("OSMP_RecvMany");
+    if(bufs == NULL || got == NULL) {
+        log_to_file(2, "Buffers and count of received messages must not be null.\n");
+        return OSMP_FAILURE;
+    }
+    if(maxn <= 0) {
+        log_to_file(2, "Cant receive zero or less messages.\n");
+        return OSMP_FAILURE;
+    }
+    unsigned int datatype_size;
+    if(OSMP_SizeOf(datatype, &datatype_size) != OSMP_SUCCESS) {
+        return OSMP_FAILURE;
+    }
+    int capacity = (int)datatype_size * count;
+
+    do {
+        // Warten, bis mindestens eine Nachricht vorliegt; sie bleibt für receive_queued() zwischengespeichert
+        if(find_matching_message(OSMP_ANY_SOURCE, OSMP_ANY_TAG, 0) == INLINE_EXHAUSTED) {
+            return OSMP_FAILURE;
+        }
+        if(receive_queued(bufs, capacity, maxn, sources, lens, got) != OSMP_SUCCESS) {
+            return OSMP_FAILURE;
+        }
+    } while(*got == 0);
+    return OSMP_SUCCESS;
+}
+
+/**
+ * Liefert die Warteschlange der Progress-Engine, die eine Request ausführt: Sendungen laufen pro Empfänger,
+ * Empfänge in einer gemeinsamen Warteschlange.
+ * @param params Die Request.
+ * @return Zeiger auf die Warteschlange.
+ */
+progress_queue* get_progress_queue(const IParams* params) {
+    return &progress_queues[params->operation == REQUEST_SEND ? params->dest : OSMP_size];
+}
+
+/**
+ * Liefert, ob completion_count einen Stand erreicht hat. Der Zähler darf dabei überlaufen.
+ * @param count  Stand von completion_count.
+ * @param target Gesuchter Stand.
+ * @return 1, wenn count target erreicht oder überschritten hat, sonst 0.
+ */
+int completions_reached(int count, int target) {
+    return (int)((unsigned int)count - (unsigned int)target) >= 0;
+}
+
+/**
+ * Markiert eine Request als abgeschlossen, vergibt ihre laufende Fertigstellungsnummer und weckt Threads in
+ * OSMP_Wait(), OSMP_Waitany() oder OSMP_Waitall(), aber nur, wenn deren Weckschwelle erreicht ist.
+ * @param params Die Request.
+ */
+void mark_request_done(IParams* params) {
+    params->completion = __atomic_add_fetch(&completion_stamps, 1, __ATOMIC_RELAXED);
+    // Zusammen mit der Reihenfolge in wait_for_request() und OSMP_Waitany() geht kein Wecken verloren
+    __atomic_store_n(&params->done, OSMP_DONE, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&params->waiters, __ATOMIC_SEQ_CST) > 0) {
+        osmp_wake_all_private(&params->done);
+    }
+    int count = __atomic_add_fetch(&completion_count, 1, __ATOMIC_SEQ_CST);
+    int wake_at = __atomic_load_n(&completion_wake_at, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&completion_waiters, __ATOMIC_SEQ_CST) > 0 && completions_reached(count, wake_at)) {
+        // Geweckte Threads, deren Schwelle noch nicht erreicht ist, tragen sie erneut ein. Hat ein Wartender die
+        // Schwelle inzwischen gesenkt, bleibt seine stehen.
+        __atomic_compare_exchange_n(&completion_wake_at, &wake_at, (int)((unsigned int)count + COMPLETION_NO_TARGET),
+                                    0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        osmp_wake_all_private(&completion_count);
+    }
+    signal_event(OSMP_rank);
+}
+
+/**
+ * Wartet, bis die laufende Operation einer Request abgeschlossen ist.
+ * @param params Die Request.
+ */
+void wait_for_request(IParams* params) {
+    if(__atomic_load_n(&params->done, __ATOMIC_ACQUIRE) == OSMP_DONE) {
+        return;
+    }
+    // Erst als Wartender eintragen, dann done prüfen
+    __atomic_add_fetch(&params->waiters, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    osmp_wait_while_equal_private(&params->done, OSMP_WAITING);
+    __atomic_sub_fetch(&params->waiters, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * Stellt einen Empfangspuffer für Sender bereit. Das gelingt nur, wenn keine zwischengespeicherte Nachricht vorliegt
+ * und kein anderer Thread das Postfach leert; der Aufrufer leert es danach selbst, bis er den Puffer wieder freigibt.
+ * @param buf      Empfangspuffer.
+ * @param capacity Größe des Empfangspuffers in Bytes.
+ * @return OSMP_SUCCESS, wenn der Puffer bereitgestellt wurde, sonst OSMP_FAILURE.
+ */
+int open_posted_receive(void *buf, int capacity) {
+    posted_receive* posted = &get_process_info(OSMP_rank)->posted;
+    // Ohne Zugriff auf fremde Adressräume (siehe OSMP_Init()) könnte kein Sender hineinschreiben
+    if(__atomic_load_n(&direct_disabled, __ATOMIC_RELAXED)) {
+        return OSMP_FAILURE;
+    }
+    pthread_mutex_lock(&pending_mutex);
+    if(arrival_first != NULL || pending_draining) {
+        pthread_mutex_unlock(&pending_mutex);
+        return OSMP_FAILURE;
+    }
+    pending_draining = 1;
+    posted->address = (uint64_t)(uintptr_t)buf;
+    posted->capacity = capacity;
+    __atomic_store_n(&posted->state, POSTED_OPEN, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&pending_mutex);
+    return OSMP_SUCCESS;
+}
+
+/**
+ * Zieht den Empfangspuffer zurück, bevor eine Nachricht aus dem Postfach entnommen wird. Hat ein Sender ihn gerade
+ * belegt, wird abgewartet, ob er hineinschreibt.
+ * @param posted Der Empfangspuffer des aufrufenden Prozesses.
+ * @return POSTED_IDLE, wenn der Puffer zurückgezogen wurde, oder POSTED_FILLED, wenn ein Sender hineingeschrieben hat.
+ */
+int settle_posted_receive(posted_receive* posted) {
+    while(1) {
+        int state = POSTED_OPEN;
+        if(__atomic_compare_exchange_n(&posted->state, &state, POSTED_IDLE, 0, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE)) {
+            return POSTED_IDLE;
+        }
+        if(state == POSTED_FILLED) {
+            return POSTED_FILLED;
+        }
+        sched_yield();
+    }
+}
+
+/**
+ * Empfängt für eine Request über das Postfach. Ist der Zwischenspeicher für Inline-Nachrichten erschöpft, bleibt die
+ * Request offen und der Empfang wird wiederholt, bis andere Empfangsaufrufe Einträge freigegeben haben.
+ * @param params Die Request.
+ */
+void receive_request_bytes(IParams* params) {
+    int tag;
+    while(receive_bytes(params->recv_buf, params->length_in_bytes, OSMP_ANY_SOURCE, OSMP_ANY_TAG, params->source, &tag,
+                        params->len) != OSMP_SUCCESS) {
+        usleep(PROGRESS_BACKOFF_US);
+    }
+}
+
+/**
+ * Empfängt für eine Request. Wenn möglich wird dabei der Zielpuffer bereitgestellt, sodass ein Sender die Nachricht
+ * direkt hineinschreiben kann; sonst wird wie bei OSMP_Recv() über das Postfach empfangen.
+ * @param params Die Request.
+ */
+void receive_posted(IParams* params) {
+    if(open_posted_receive(params->recv_buf, params->length_in_bytes) != OSMP_SUCCESS) {
+        receive_request_bytes(params);
+        return;
+    }
+
+    process_info* process = get_process_info(OSMP_rank);
+    posted_receive* posted = &process->posted;
+    int message;
+    while(1) {
+        osmp_sem_wait(&process->postbox.sem_proc_full);
+        int state = settle_posted_receive(posted);
+        message = postbox_dequeue();
+        if(message == DIRECT_ENTRY || state == POSTED_IDLE) {
+            break;
+        }
+        if(message == INLINE_EXHAUSTED) {
+            // Der Sender hat bereits direkt geschrieben; der DIRECT_ENTRY muss trotzdem noch entnommen werden
+            usleep(PROGRESS_BACKOFF_US);
+            continue;
+        }
+        // Nachrichten anderer Sender, die vor dem DIRECT_ENTRY ankommen, bleiben für spätere Empfänge liegen
+        pthread_mutex_lock(&pending_mutex);
+        pending_append(message);
+        pthread_cond_broadcast(&pending_condition);
+        pthread_mutex_unlock(&pending_mutex);
+    }
+    if(message == DIRECT_ENTRY) {
+        *params->source = posted->source;
+        *params->len = posted->len;
+        __atomic_store_n(&posted->state, POSTED_IDLE, __ATOMIC_RELEASE);
+    }
 
-    int slot_index = get_next_message();
-    message_slot* slot = &(shm_ptr->slots[slot_index]);
+    pthread_mutex_lock(&pending_mutex);
+    pending_draining = 0;
+    pthread_cond_broadcast(&pending_condition);
+    pthread_mutex_unlock(&pending_mutex);
 
-    if(length_in_bytes < slot->len) {
+    if(message == DIRECT_ENTRY) {
+        return;
+    }
+    if(message == INLINE_EXHAUSTED) {
+        receive_request_bytes(params);
+        return;
+    }
+    *params->source = get_message_source(message);
+    *params->len = get_message_length(message);
+    if(params->length_in_bytes < *params->len) {
         log_to_file(3, "Recv buffer too small!\n");
     }
-    memcpy(buf, slot->payload, (unsigned long) length_in_bytes);
-    *source = slot->from;
-    *len = slot->len;
-    memset(shm_ptr->slots[slot_index].payload, '\0', OSMP_MAX_PAYLOAD_LENGTH);
+    if(consume_message(message, params->recv_buf, params->length_in_bytes) != OSMP_SUCCESS) {
+        // Abgelehnte Rendezvous-Nachricht: der Sender schickt sie erneut
+        receive_request_bytes(params);
+    }
+}
+
+/**
+ * Führt die Operation einer Request blockierend aus. Die Argumente wurden beim Starten bzw. Binden geprüft.
+ * @param params Die Request.
+ */
+void execute_request(IParams* params) {
+    if(params->operation == REQUEST_SEND) {
+        send_bytes(params->send_buf, params->length_in_bytes, params->datatype, params->dest, 0);
+    } else {
+        receive_posted(params);
+    }
+}
+
+/**
+ * Hängt eine Warteschlange mit wartenden Requests an die Liste der bereiten Warteschlangen an, sofern sie dort nicht
+ * schon steht oder gerade ausgeführt wird. Der Aufrufer muss progress_mutex halten.
+ * @param queue Die Warteschlange.
+ */
+void schedule_progress_queue(progress_queue* queue) {
+    if(queue->scheduled || queue->first == NULL) {
+        return;
+    }
+    queue->scheduled = 1;
+    queue->next_ready = NULL;
+    if(progress_ready_last != NULL) {
+        progress_ready_last->next_ready = queue;
+    } else {
+        progress_ready_first = queue;
+    }
+    progress_ready_last = queue;
+    progress_ready_count++;
+    pthread_cond_signal(&progress_condition);
+}
 
-    pthread_mutex_lock(&shm_ptr->mutex_shm_free_slots);
+/**
+ * Führt die älteste Request einer Warteschlange aus, falls das möglich ist. Sendungen, die inline oder in einem
+ * Nachrichtenslot verschickt werden, werden nur versucht; alle anderen Operationen blockieren und werden nur
+ * ausgeführt, solange ein Hilfsthread für nicht blockierende Sendungen frei bleibt. Der Aufrufer muss progress_mutex
+ * halten; er wird während der Operation freigegeben.
+ * @param params Die älteste Request der Warteschlange.
+ * @return 1, wenn die Request ausgeführt wurde, sonst 0.
+ */
+int progress_request(IParams* params) {
+    int done;
+    if(params->operation == REQUEST_SEND && !send_may_block(params->length_in_bytes)) {
+        pthread_mutex_unlock(&progress_mutex);
+        done = try_send_bytes(params->send_buf, params->length_in_bytes, params->datatype, params->dest, 0)
+               == OSMP_SUCCESS;
+        pthread_mutex_lock(&progress_mutex);
+        return done;
+    }
+    if(progress_blocking >= PROGRESS_THREADS - 1) {
+        return 0;
+    }
+    progress_blocking++;
+    pthread_mutex_unlock(&progress_mutex);
+    execute_request(params);
+    pthread_mutex_lock(&progress_mutex);
+    progress_blocking--;
+    return 1;
+}
 
-    // Lies aktuellen Index in der Liste freier Slots
-    int list_index = shm_ptr->free_slots_index;
-    // Füge eben geleertes Postfach zur Liste hinzu
-    shm_ptr->free_slots[list_index-1] = slot_index;
-    // Passe Listenindex an
-    (shm_ptr->free_slots_index)--;
+/**
+ * Hilfsthread der Progress-Engine. Nimmt reihum die bereiten Warteschlangen und führt jeweils deren älteste Request
+ * aus, bis die Engine beendet wird und keine Request mehr wartet. Kommt in einer ganzen Runde keine Request voran,
+ * wartet der Thread kurz, bis die Empfänger Platz geschaffen haben.
+ * @param args Unbenutzt.
+ * @return NULL.
+ */
+void * OSMP_thread_progress(void* args){
+    (void) args;
+    log_osmp_lib_call("OSMP_thread_progress");
+    int failures = 0;
+
+    pthread_mutex_lock(&progress_mutex);
+    while(1) {
+        while(progress_ready_first == NULL && !progress_stopping) {
+            progress_idle++;
+            pthread_cond_wait(&progress_condition, &progress_mutex);
+            progress_idle--;
+        }
+        if(progress_ready_first == NULL) {
+            break;
+        }
+        progress_queue* queue = progress_ready_first;
+        progress_ready_first = queue->next_ready;
+        if(progress_ready_first == NULL) {
+            progress_ready_last = NULL;
+        }
+        progress_ready_count--;
+
+        // Die Warteschlange bleibt bis nach der Fertigstellung als geplant markiert, sodass kein anderer Thread ihre
+        // nächste Request vorzieht oder früher abschließt
+        IParams* params = queue->first;
+        int done = progress_request(params);
+        if(done) {
+            queue->first = params->next;
+            if(queue->first == NULL) {
+                queue->last = NULL;
+            }
+            pthread_mutex_unlock(&progress_mutex);
+            // Setze Flag und benachrichtige über Fertigstellung
+            mark_request_done(params);
+            pthread_mutex_lock(&progress_mutex);
+            queue->busy--;
+            failures = 0;
+        }
+        queue->scheduled = 0;
+        schedule_progress_queue(queue);
+
+        if(!done && ++failures > progress_ready_count) {
+            failures = 0;
+            pthread_mutex_unlock(&progress_mutex);
+            usleep(PROGRESS_BACKOFF_US);
+            pthread_mutex_lock(&progress_mutex);
+        }
+    }
+    pthread_mutex_unlock(&progress_mutex);
+    return NULL;
+}
 
-    pthread_mutex_unlock(&shm_ptr->mutex_shm_free_slots);
+/**
+ * Reiht eine Request in ihre Warteschlange der Progress-Engine ein und startet bei Bedarf einen weiteren Hilfsthread
+ * des Pools. Eine Sendung, vor der keine ältere an denselben Empfänger aussteht, wird zuerst direkt versucht und ist
+ * bei Erfolg sofort abgeschlossen. Der Versuch läuft ohne progress_mutex; solange bleibt die Warteschlange als
+ * geplant markiert, sodass kein Hilfsthread eine spätere Sendung an denselben Empfänger vorzieht.
+ * @param params Die Request mit gesetzter Operation und geprüften Argumenten.
+ * @return Im Erfolgsfall OSMP_SUCCESS, sonst OSMP_FAILURE
+ */
+int enqueue_request(IParams* params) {
+    log_osmp_lib_call("enqueue_request");
+    progress_queue* queue = get_progress_queue(params);
+
+    params->reported = 0;
+    __atomic_store_n(&params->done, OSMP_WAITING, __ATOMIC_RELAXED);
+    params->next = NULL;
+    pthread_mutex_lock(&progress_mutex);
+    int attempted = 0;
+    if(params->operation == REQUEST_SEND && queue->busy == 0) {
+        attempted = 1;
+        queue->busy++;
+        queue->scheduled = 1;
+        pthread_mutex_unlock(&progress_mutex);
+        int sent = try_send_bytes(params->send_buf, params->length_in_bytes, params->datatype, params->dest, 0);
+        if(sent == OSMP_SUCCESS) {
+            mark_request_done(params);
+        }
+        pthread_mutex_lock(&progress_mutex);
+        if(sent == OSMP_SUCCESS) {
+            queue->busy--;
+            queue->scheduled = 0;
+            // Während des Versuchs eingereihte Requests warten auf einen Hilfsthread
+            schedule_progress_queue(queue);
+            pthread_mutex_unlock(&progress_mutex);
+            return OSMP_SUCCESS;
+        }
+    }
 
-    sem_post(&shm_ptr->sem_shm_free_slots);
+    if(progress_idle == 0 && progress_thread_count < PROGRESS_THREADS) {
+        if(pthread_create(&progress_threads[progress_thread_count], NULL, OSMP_thread_progress, NULL) == 0) {
+            progress_thread_count++;
+        } else if(progress_thread_count == 0) {
+            if(attempted) {
+                queue->busy--;
+                queue->scheduled = 0;
+            }
+            pthread_mutex_unlock(&progress_mutex);
+            log_to_file(3, "pthread_create failed");
+            mark_request_done(params);
+            return OSMP_FAILURE;
+        }
+    }
+    if(attempted) {
+        // Die Request ist älter als alle, die während des Versuchs eingereiht wurden
+        params->next = queue->first;
+        queue->first = params;
+        if(queue->last == NULL) {
+            queue->last = params;
+        }
+        queue->scheduled = 0;
+    } else {
+        if(queue->last != NULL) {
+            queue->last->next = params;
+        } else {
+            queue->first = params;
+        }
+        queue->last = params;
+        queue->busy++;
+    }
+    schedule_progress_queue(queue);
+    pthread_mutex_unlock(&progress_mutex);
     return OSMP_SUCCESS;
 }
 
+/**
+ * Wartet, bis alle gestarteten Requests ausgeführt sind, und beendet die Hilfsthreads der Progress-Engine.
+ */
+void stop_progress_engine(void) {
+    log_osmp_lib_call("stop_progress_engine");
+    pthread_mutex_lock(&progress_mutex);
+    progress_stopping = 1;
+    pthread_cond_broadcast(&progress_condition);
+    pthread_mutex_unlock(&progress_mutex);
+    for(int i = 0; i < progress_thread_count; i++) {
+        pthread_join(progress_threads[i], NULL);
+    }
+    progress_thread_count = 0;
+    free(progress_queues);
+    progress_queues = NULL;
+}
+
+/**
+ * Entnimmt dem Request-Pool des Prozesses eine freie Request. Nur wenn keine frei ist, wird ein weiterer Block
+ * angelegt.
+ * @return Die Request oder NULL, wenn der Pool erschöpft ist.
+ */
+IParams* take_request(void) {
+    pthread_mutex_lock(&request_mutex);
+    if(request_free == NULL) {
+        IParams* block = NULL;
+        if(request_block_count < REQUEST_BLOCKS) {
+            block = malloc(REQUEST_BLOCK_SIZE * sizeof(IParams));
+        }
+        if(block == NULL) {
+            pthread_mutex_unlock(&request_mutex);
+            return NULL;
+        }
+        for(int i = 0; i < REQUEST_BLOCK_SIZE; i++) {
+            block[i].next = i + 1 < REQUEST_BLOCK_SIZE ? &block[i + 1] : NULL;
+        }
+        request_blocks[request_block_count++] = block;
+        request_free = block;
+    }
+    IParams* params = request_free;
+    request_free = params->next;
+    pthread_mutex_unlock(&request_mutex);
+    return params;
+}
+
+/**
+ * Gibt eine Request an den Request-Pool des Prozesses zurück.
+ * @param params Die Request.
+ */
+void return_request(IParams* params) {
+    pthread_mutex_lock(&request_mutex);
+    params->next = request_free;
+    request_free = params;
+    pthread_mutex_unlock(&request_mutex);
+}
+
+/**
+ * Gibt alle Blöcke des Request-Pools frei. Danach sind alle Requests des Prozesses ungültig.
+ */
+void free_request_pool(void) {
+    pthread_mutex_lock(&request_mutex);
+    for(int i = 0; i < request_block_count; i++) {
+        free(request_blocks[i]);
+    }
+    request_block_count = 0;
+    request_free = NULL;
+    pthread_mutex_unlock(&request_mutex);
+}
+
 int OSMP_Finalize(void) {
     log_osmp_lib_call("OSMP_Finalize");
-    int result, semval;
+    int result;
 
     process_info* info = get_process_info(OSMP_rank);
 
     // Ein Flag, damit es bewusst wird, dass der Prozess nicht erreichbar ist.
     info->available = NOT_AVAILABLE;
 
-    pthread_mutex_lock(&(info->postbox.sem_proc_full_value_mutex));
-    semval = info->postbox.sem_proc_full_value;
-    pthread_mutex_unlock(&(info->postbox.sem_proc_full_value_mutex));
-
+    stop_progress_engine();
+    stop_event_thread();
 
-    wait_and_finalize_all_threads();
-
-    if(semval > 0) {
-        // lies alle restlichen Nachrichten
-        char* buffer[OSMP_MAX_PAYLOAD_LENGTH];
-        int source, len;
-        for(int i=0; i<semval; i++) {
-            //Weil count>0 ist, kann nie False zurückgegeben werden.
-            OSMP_Recv(buffer, OSMP_MAX_PAYLOAD_LENGTH, OSMP_BYTE, &source, &len);
+    // lies alle restlichen Nachrichten, auch die bereits zwischengespeicherten
+    int got;
+    int max = shm_ptr->max_slots + OSMP_size * RENDEZVOUS_DESCRIPTORS;
+    do {
+        if(receive_queued(NULL, 0, max, NULL, NULL, &got) != OSMP_SUCCESS) {
+            return OSMP_FAILURE;
         }
+    } while(got > 0);
+    free(pending_nodes);
+    free(pending_first);
+    free(pending_last);
+    for(int i = 0; i < inline_block_count; i++) {
+        free(inline_blocks[i]);
     }
+    free(inline_blocks);
+    free_request_pool();
 
-
-    result = pthread_mutex_destroy(thread_linked_list_mutex);
-    if(result != 0) {
-        log_to_file(3, "Couldn't destroy mutex thread_linked_list_mutex in finalize!\n");
-        return OSMP_FAILURE;
-    }
-    free(thread_linked_list_mutex);
     result = close(shared_memory_fd);
     if(result==-1){
         log_to_file(3, "Couldn't close shared memory FD.");
         return OSMP_FAILURE;
     }
-    result = munmap(shm_ptr, (size_t)memory_size);
+    result = munmap(shm_ptr, get_mapping_length((size_t)memory_size, huge_page_segment));
     if(result==-1){
         log_to_file(3, "Couldn't unmap memory.");
         return OSMP_FAILURE;
@@ -520,7 +2987,7 @@ int OSMP_Gather(void *sendbuf, int sendcount, OSMP_Datatype sendtype, void *recv
     unsigned int send_length_in_bytes, receive_length_in_bytes;
     OSMP_SizeOf(sendtype, &send_datatype_size);
     send_length_in_bytes = send_datatype_size * (unsigned int) sendcount;
-    if(send_length_in_bytes > OSMP_MAX_PAYLOAD_LENGTH){
+    if(send_length_in_bytes > (unsigned int)shm_ptr->max_payload_length){
         log_to_file(3, "Trying to send more bytes than the payload size.\n");
         return OSMP_FAILURE;
     }
@@ -531,327 +2998,616 @@ int OSMP_Gather(void *sendbuf, int sendcount, OSMP_Datatype sendtype, void *recv
         log_to_file(3, "The size of the receiving buffer isn't the same, as the writing size.\n");
         return OSMP_FAILURE;
     }
-    // Kopiere zu sendene Nachricht in den eigenen Gather-Slot
-    mempcpy(&(process->gather_slot.payload), sendbuf, send_length_in_bytes);
+    // Trage die Länge des eigenen Beitrags ein und warte, bis alle Prozesse ihre Länge eingetragen haben
     process->gather_slot.len = (int) send_length_in_bytes;
-    // Warte, bis alle Prozesse geschrieben haben
     OSMP_Barrier();
 
-    // Nur der Root-Prozess (empfangender Prozess) sammelt alle Nachrichten
-    if(rank == root) {
-        int max_bytes = (int)(send_datatype_size) * recvcount;
-
+    if(rank != root) {
+        // Kopiere zu sendende Nachricht in einen Heap-Block und melde sie dem Root-Prozess
+        int heap_class_index = get_heap_class((int) send_length_in_bytes);
+        int block = heap_alloc(heap_class_index, &process->gather_slot.block_owner);
+        memcpy(get_heap_block(heap_class_index, block), sendbuf, send_length_in_bytes);
+        process->gather_slot.heap_class = heap_class_index;
+        process->gather_slot.block = block;
+        __atomic_store_n(&(process->gather_ready), 1, __ATOMIC_RELEASE);
+        osmp_sem_post(&shm_ptr->sem_gather);
+    } else {
+        // Nur der Root-Prozess (empfangender Prozess) sammelt alle Nachrichten
         pthread_mutex_lock(&shm_ptr->gather_mutex);
-        OSMP_SizeOf(recvtype, &send_datatype_size);
-        char * temp = recvbuf;
-        int written = 0;
 
+        // Position jedes Beitrags im Empfangspuffer (Beiträge liegen nach Rang sortiert hintereinander)
+        size_t block_offsets[OSMP_size];
+        size_t written = 0;
         for (int i = 0; i < OSMP_size; ++i) {
-            process_info * process_to_read_from = get_process_info(i);
-            int to_copy = process_to_read_from->gather_slot.len;
-            if(to_copy > (max_bytes - written)) {
-                // recv-Buffer ist nicht groß genug für die folgende Nachricht
-                break;
+            block_offsets[i] = written;
+            written += (size_t) get_process_info(i)->gather_slot.len;
+        }
+
+        char * temp = recvbuf;
+        if(block_offsets[rank] + send_length_in_bytes <= receive_length_in_bytes) {
+            memcpy(temp + block_offsets[rank], sendbuf, send_length_in_bytes);
+        }
+
+        /* Die Beiträge werden in der Reihenfolge gelesen, in der sie bereitstehen. Dadurch werden Heap-Blöcke sofort
+         * wieder frei und Prozesse, die noch auf einen Block warten, blockieren sich nicht gegenseitig. */
+        int next = 0;
+        for (int received = 1; received < OSMP_size; ++received) {
+            osmp_sem_wait(&shm_ptr->sem_gather);
+            process_info * process_to_read_from = NULL;
+            while(process_to_read_from == NULL) {
+                process_info * candidate = get_process_info(next);
+                if(next != rank && __atomic_exchange_n(&(candidate->gather_ready), 0, __ATOMIC_ACQUIRE)) {
+                    process_to_read_from = candidate;
+                }
+                next = (next + 1) % OSMP_size;
             }
-            mempcpy(temp, &(process_to_read_from->gather_slot.payload),
-                    (unsigned long) to_copy);
-            temp += to_copy;
-            written += to_copy;
+
+            message_slot * gather_slot = &(process_to_read_from->gather_slot);
+            size_t offset = block_offsets[process_to_read_from->rank];
+            if(offset + (size_t) gather_slot->len <= receive_length_in_bytes) {
+                memcpy(temp + offset, get_heap_block(gather_slot->heap_class, gather_slot->block),
+                       (unsigned long) gather_slot->len);
+            } else {
+                // recv-Buffer ist nicht groß genug für diese Nachricht
+                log_to_file(3, "Gather recv buffer too small for a contribution.\n");
+            }
+            heap_free(gather_slot->heap_class, gather_slot->block, gather_slot->block_owner);
         }
-        
+
         pthread_mutex_unlock(&shm_ptr->gather_mutex);
     }
     // Warte, bis Root gelesen hat
     OSMP_Barrier();
+
+    // Hat kein Prozess den Beitrag gelesen (uneinheitlicher Root), wird der Heap-Block wieder freigegeben
+    if(rank != root && __atomic_exchange_n(&(process->gather_ready), 0, __ATOMIC_ACQUIRE)) {
+        osmp_sem_trywait(&shm_ptr->sem_gather);
+        heap_free(process->gather_slot.heap_class, process->gather_slot.block, process->gather_slot.block_owner);
+    }
     return OSMP_SUCCESS;
 }
 
+
 /**
- * Asynchron starten vom send durch einen Thread.
- * @param args die Argumente für den thread.
- * @return Im Erfolgsfall Null, sonst OSMP_FAILURE
+ * Prüft, ob eine Request für eine neue Operation verwendet werden kann: Sie darf weder dauerhaft gebunden sein noch
+ * eine laufende Operation haben.
+ * @param request Die Request.
+ * @return OSMP_SUCCESS, wenn die Request verwendet werden kann, sonst OSMP_FAILURE.
  */
-void * OSMP_thread_send(void* args){
-    log_osmp_lib_call("OSMP_thread_send");
-
-    if(args == NULL) {
-        log_to_file(3, "Arguments were null!");
-        return (void *) OSMP_FAILURE;
+int check_unbound_request(OSMP_Request request) {
+    if(request == NULL) {
+        log_to_file(3, "OSMP_Request was null!");
+        return OSMP_FAILURE;
     }
-
-    IParams* params = (IParams*) args;
-
-    // Variablen aus Struct lokal kopieren
-    int result = pthread_mutex_lock(&(params->mutex));
-    if(result != 0){
-        log_to_file(3, "Failed to lock mutex.");
-        return (void *) OSMP_FAILURE;
+    IParams* params = (IParams*)request;
+    if(params->persistent) {
+        log_to_file(2, "OSMP_Request is already bound to a persistent operation.\n");
+        return OSMP_FAILURE;
     }
-    const void* buf = params->send_buf;
-    int count = params->count;
-    OSMP_Datatype datatype = params->datatype;
-    int dest = params->dest;
-    pthread_mutex_unlock(&(params->mutex));
-
-    // Starte eigentliche Recv-Operation
-    OSMP_Send(buf, count, datatype, dest);
-
-    // Setze Flag
-    pthread_mutex_lock(&(params->mutex));
-    params->done = OSMP_DONE;
+    if(params->operation != REQUEST_IDLE && __atomic_load_n(&params->done, __ATOMIC_ACQUIRE) == OSMP_WAITING) {
+        log_to_file(2, "OSMP_Request is still active.\n");
+        return OSMP_FAILURE;
+    }
+    return OSMP_SUCCESS;
+}
 
-    // Benachrichtige über Fertigstellung
-    pthread_cond_broadcast(&(params->convar));
-    pthread_mutex_unlock(&(params->mutex));
+/**
+ * Prüft die Argumente eines nicht blockierenden Sendens und berechnet die Länge der Nachricht.
+ * @param count           Zahl der Elemente.
+ * @param datatype        OSMP-Typ der Elemente.
+ * @param dest            Rang des Empfängers.
+ * @param length_in_bytes Länge der Nachricht in Bytes.
+ * @return OSMP_SUCCESS, wenn die Argumente gültig sind, sonst OSMP_FAILURE.
+ */
+int get_send_length(int count, OSMP_Datatype datatype, int dest, int* length_in_bytes) {
+    if(count <= 0) {
+        log_to_file(2, "Cant send with count zero or less.\n");
+        return OSMP_FAILURE;
+    }
+    if(dest>=OSMP_size || dest<0){
+        log_to_file(2, "Destination must be between zero and OSMP_size.\n");
+        return OSMP_FAILURE;
+    }
+    unsigned int datatype_size;
+    if(OSMP_SizeOf(datatype, &datatype_size) != OSMP_SUCCESS) {
+        return OSMP_FAILURE;
+    }
+    *length_in_bytes = (int)datatype_size * count;
+    return OSMP_SUCCESS;
+}
 
-    return NULL;
+/**
+ * Prüft die Argumente eines nicht blockierenden Empfangens und berechnet die Größe des Zielpuffers.
+ * @param count           Zahl der Elemente.
+ * @param datatype        OSMP-Typ der Elemente.
+ * @param source          Ausgabeparameter für den Sender.
+ * @param len             Ausgabeparameter für die Länge.
+ * @param length_in_bytes Größe des Zielpuffers in Bytes.
+ * @return OSMP_SUCCESS, wenn die Argumente gültig sind, sonst OSMP_FAILURE.
+ */
+int get_recv_length(int count, OSMP_Datatype datatype, const int* source, const int* len, int* length_in_bytes) {
+    if(count <= 0) {
+        log_to_file(2, "Cant receive with count zero or less.\n");
+        return OSMP_FAILURE;
+    }
+    if(source == NULL || len == NULL) {
+        log_to_file(2, "Output parameters of a non-blocking receive must not be null.\n");
+        return OSMP_FAILURE;
+    }
+    unsigned int datatype_size;
+    if(OSMP_SizeOf(datatype, &datatype_size) != OSMP_SUCCESS) {
+        return OSMP_FAILURE;
+    }
+    *length_in_bytes = (int)datatype_size * count;
+    return OSMP_SUCCESS;
 }
 
 int OSMP_ISend(const void *buf, int count, OSMP_Datatype datatype, int dest, OSMP_Request request) {
     log_osmp_lib_call("OSMP_ISend");
 
-    if(request == NULL) {
-        log_to_file(3, "OSMP_Request was null!");
+    int length_in_bytes;
+    if(check_unbound_request(request) != OSMP_SUCCESS
+       || get_send_length(count, datatype, dest, &length_in_bytes) != OSMP_SUCCESS) {
         return OSMP_FAILURE;
     }
 
     // Kopiere Parameter in Request
     IParams* params = (IParams*)request;
-    pthread_mutex_lock(&(params->mutex));
     params->send_buf = buf;
     params->count = count;
     params->datatype = datatype;
     params->dest = dest;
-    pthread_mutex_unlock(&(params->mutex));
+    params->operation = REQUEST_SEND;
+    params->length_in_bytes = length_in_bytes;
+
+    // Der Hilfsthread des Empfängers führt das Senden aus
+    return enqueue_request(params);
+}
+
+int OSMP_IRecv(void *buf, int count, OSMP_Datatype datatype, int *source, int *len, OSMP_Request request) {
+    log_osmp_lib_call("OSMP_IRecv");
 
-    // Erzeuge Thread in linked list
-    pthread_t* thread;
-    int result = create_thread(&thread);
-    if( result == OSMP_FAILURE){
+    int length_in_bytes;
+    if(check_unbound_request(request) != OSMP_SUCCESS
+       || get_recv_length(count, datatype, source, len, &length_in_bytes) != OSMP_SUCCESS) {
         return OSMP_FAILURE;
     }
 
-    // Starte Thread
-    int rv = pthread_create(thread, NULL, OSMP_thread_send, request);
-    if(rv != 0) {
-        puts("pthread_create failed");
-        perror("pthread_create_failed");
-        log_to_file(3, "pthread_create failed");
+    // Kopiere Parameter in Request
+    IParams* params = (IParams*)request;
+    params->recv_buf = buf;
+    params->count = count;
+    params->datatype = datatype;
+    params->source = source;
+    params->len = len;
+    params->operation = REQUEST_RECV;
+    params->length_in_bytes = length_in_bytes;
+
+    // Der Hilfsthread für Empfänge führt die Requests in Reihenfolge ihres Starts aus
+    return enqueue_request(params);
+}
+
+int OSMP_Test(OSMP_Request request, int *flag) {
+    log_osmp_lib_call("OSMP_Test");
+
+    if(request == NULL) {
+        log_to_file(3, "OSMP_Request was null!");
         return OSMP_FAILURE;
     }
+
+    IParams* params = (IParams*)request;
+    *flag = __atomic_load_n(&params->done, __ATOMIC_ACQUIRE);
     return OSMP_SUCCESS;
 }
 
-void * OSMP_thread_recv(void* args){
-    log_osmp_lib_call("OSMP_thread_recv");
+int OSMP_Wait(OSMP_Request request) {
+    log_osmp_lib_call("OSMP_Wait");
 
-    if(args == NULL) {
-        log_to_file(3, "Arguments were null!");
-        return (void *) OSMP_FAILURE;
+    if(request == NULL) {
+        log_to_file(3, "OSMP_Request was null!");
+        return OSMP_FAILURE;
     }
 
-    IParams* params = (IParams*) args;
-
-    // in-Variablen (und Buffer) aus Struct lokal kopieren
-    pthread_mutex_lock(&(params->mutex));
-    void* buf = params->recv_buf;
-    int count = params->count;
-    OSMP_Datatype datatype = params->datatype;
-    pthread_mutex_unlock(&(params->mutex));
+    IParams* params = (IParams*)request;
 
-    // out-Variablen zunächst lokal
-    int source;
-    int len;
+    // Warte, bis Vorgang abgeschlossen ist
+    wait_for_request(params);
+    return OSMP_SUCCESS;
+}
 
-    // Starte eigentliche Recv-Operation
-    OSMP_Recv(buf, count, datatype, &source, &len);
+int OSMP_CreateRequest(OSMP_Request *request) {
+    log_osmp_lib_call("OSMP_CreateRequest");
 
-    pthread_mutex_lock(&(params->mutex));
+    if(request == NULL) {
+        log_to_file(3, "OSMP_Request was null!");
+        return OSMP_FAILURE;
+    }
 
-    // out-Variablen an die passenden Stellen des Aufrufers kopieren
-    *(params->source) = source;
-    *(params->len) = len;
+    // Entnimm eine Request aus dem Pool des Prozesses
+    IParams* params = take_request();
+    if(params == NULL) {
+        log_to_file(3, "Couldn't allocate space for OSMP_Request");
+        return OSMP_FAILURE;
+    }
+    memset(params, 0, sizeof(IParams));
 
     // Setze Flag
-    params->done = OSMP_DONE;
+    params->done = OSMP_WAITING;
+
+    // caste auf opaken Datentypen und setze den oben übergebenen Pointer
+    *request = (OSMP_Request*) params;
+    return OSMP_SUCCESS;
+}
+
+int OSMP_RemoveRequest(OSMP_Request *request) {
+    log_osmp_lib_call("OSMP_RemoveRequest");
+
+    if(request == NULL || *request == NULL) {
+        log_to_file(3, "OSMP_Request was null!");
+        return OSMP_FAILURE;
+    }
 
-    // Benachrichtige über Fertigstellung
-    pthread_cond_broadcast(&(params->convar));
+    // Caste opaken Datentypen auf unser internes Struct
+    IParams* params = (IParams*)*request;
 
-    pthread_mutex_unlock(&(params->mutex));
+    // Die Progress-Engine darf die Request nach dem Freigeben nicht mehr anfassen
+    if(params->operation != REQUEST_IDLE) {
+        wait_for_request(params);
+    }
 
-    return NULL;
+    return_request(params);
+    *request = NULL;
+    return OSMP_SUCCESS;
 }
 
-int OSMP_IRecv(void *buf, int count, OSMP_Datatype datatype, int *source, int *len, OSMP_Request request) {
-    log_osmp_lib_call("OSMP_IRecv");
+int OSMP_Send_init(const void *buf, int count, OSMP_Datatype datatype, int dest, OSMP_Request request) {
+    log_osmp_lib_call("OSMP_Send_init");
+    int length_in_bytes;
+    if(check_unbound_request(request) != OSMP_SUCCESS
+       || get_send_length(count, datatype, dest, &length_in_bytes) != OSMP_SUCCESS) {
+        return OSMP_FAILURE;
+    }
 
-    if(request == NULL) {
-        log_to_file(3, "OSMP_Request was null!");
+    IParams* params = (IParams*)request;
+    params->send_buf = buf;
+    params->count = count;
+    params->datatype = datatype;
+    params->dest = dest;
+    params->operation = REQUEST_SEND;
+    params->length_in_bytes = length_in_bytes;
+    params->persistent = 1;
+    // Bis zum ersten Start gilt die Request als abgeschlossen und gemeldet
+    params->reported = 1;
+    __atomic_store_n(&params->done, OSMP_DONE, __ATOMIC_RELEASE);
+    return OSMP_SUCCESS;
+}
+
+int OSMP_Recv_init(void *buf, int count, OSMP_Datatype datatype, int *source, int *len, OSMP_Request request) {
+    log_osmp_lib_call("OSMP_Recv_init");
+    int length_in_bytes;
+    if(check_unbound_request(request) != OSMP_SUCCESS
+       || get_recv_length(count, datatype, source, len, &length_in_bytes) != OSMP_SUCCESS) {
         return OSMP_FAILURE;
     }
 
-    // Kopiere Parameter in Request
     IParams* params = (IParams*)request;
-    pthread_mutex_lock(&(params->mutex));
     params->recv_buf = buf;
     params->count = count;
     params->datatype = datatype;
     params->source = source;
     params->len = len;
-    pthread_mutex_unlock(&(params->mutex));
+    params->operation = REQUEST_RECV;
+    params->length_in_bytes = length_in_bytes;
+    params->persistent = 1;
+    params->reported = 1;
+    __atomic_store_n(&params->done, OSMP_DONE, __ATOMIC_RELEASE);
+    return OSMP_SUCCESS;
+}
 
-    // Erzeuge Thread in linked list
-    pthread_t* thread;
-    int result = create_thread(&thread);
-    if( result == OSMP_FAILURE){
+/**
+ * Prüft, ob eine Request persistent ist und ihre vorherige Operation abgeschlossen hat.
+ * @param request Die Request.
+ * @return OSMP_SUCCESS, wenn die Request gestartet werden kann, sonst OSMP_FAILURE.
+ */
+int check_startable_request(OSMP_Request request) {
+    if(request == NULL) {
+        log_to_file(3, "OSMP_Request was null!");
         return OSMP_FAILURE;
     }
-
-    // Starte Thread
-    int rv = pthread_create(thread, NULL, OSMP_thread_recv, request);
-    if(rv != 0) {
-        puts("pthread_create failed");
-        log_to_file(3, "pthread_create failed");
+    IParams* params = (IParams*)request;
+    if(!params->persistent) {
+        log_to_file(2, "OSMP_Request is not persistent.\n");
+        return OSMP_FAILURE;
+    }
+    if(__atomic_load_n(&params->done, __ATOMIC_ACQUIRE) != OSMP_DONE) {
+        log_to_file(2, "Persistent OSMP_Request is still active.\n");
         return OSMP_FAILURE;
     }
     return OSMP_SUCCESS;
 }
 
-int OSMP_Test(OSMP_Request request, int *flag) {
-    log_osmp_lib_call("OSMP_Test");
-
-    if(request == NULL) {
-        log_to_file(3, "OSMP_Request was null!");
+int OSMP_Start(OSMP_Request request) {
+    log_osmp_lib_call("OSMP_Start");
+    if(check_startable_request(request) != OSMP_SUCCESS) {
         return OSMP_FAILURE;
     }
+    return enqueue_request((IParams*)request);
+}
 
-    IParams* params = (IParams*)request;
-
-    // Prüfe, ob Mutex frei ist
-    int result = pthread_mutex_trylock(&(params->mutex));
-
-    // kein Lock auf Mutex
-    if(result != 0) {
-        *flag = OSMP_WAITING;
-        return OSMP_SUCCESS;
+int OSMP_Startall(int count, OSMP_Request *requests) {
+    log_osmp_lib_call("OSMP_Startall");
+    if(requests == NULL || count < 0) {
+        log_to_file(2, "Invalid array of requests.\n");
+        return OSMP_FAILURE;
+    }
+    // Erst alle prüfen, damit ein ungültiges Feld nicht teilweise gestartet wird
+    for(int i = 0; i < count; i++) {
+        if(check_startable_request(requests[i]) != OSMP_SUCCESS) {
+            return OSMP_FAILURE;
+        }
+    }
+    for(int i = 0; i < count; i++) {
+        if(enqueue_request((IParams*)requests[i]) != OSMP_SUCCESS) {
+            return OSMP_FAILURE;
+        }
     }
-
-    // sonst: Mutex-Lock erhalten
-    *flag = params->done;
-
-    pthread_mutex_unlock(&(params->mutex));
     return OSMP_SUCCESS;
 }
 
-int OSMP_Wait(OSMP_Request request) {
-    log_osmp_lib_call("OSMP_Wait");
-
-    if(request == NULL) {
-        log_to_file(3, "OSMP_Request was null!");
+/**
+ * Prüft das Feld von Requests, das an OSMP_Waitall(), OSMP_Waitany(), OSMP_Testall() oder OSMP_Testsome() übergeben
+ * wurde.
+ * @param count    Anzahl der Requests.
+ * @param requests Feld mit count Requests.
+ * @param result   Ausgabeparameter der Funktion.
+ * @return OSMP_SUCCESS, wenn die Argumente gültig sind, sonst OSMP_FAILURE.
+ */
+int check_request_array(int count, const OSMP_Request *requests, const void* result) {
+    if(count < 0 || (requests == NULL && count > 0)) {
+        log_to_file(2, "Invalid array of requests.\n");
+        return OSMP_FAILURE;
+    }
+    if(result == NULL) {
+        log_to_file(2, "Output parameter must not be null.\n");
         return OSMP_FAILURE;
     }
+    return OSMP_SUCCESS;
+}
 
-    IParams* params = (IParams*)request;
+/**
+ * Liefert, ob eine Request aus einem Feld noch aussteht, d.h. gestartet wurde und ihre Fertigstellung noch nicht
+ * von OSMP_Waitany() oder OSMP_Testsome() gemeldet wurde.
+ * @param params Die Request oder NULL.
+ * @return 1, wenn die Request aussteht, sonst 0.
+ */
+int is_pending_request(const IParams* params) {
+    if(params == NULL || params->operation == REQUEST_IDLE) {
+        return 0;
+    }
+    return !params->reported || __atomic_load_n(&params->done, __ATOMIC_ACQUIRE) != OSMP_DONE;
+}
+
+/**
+ * Sucht unter den ausstehenden Requests die am frühesten abgeschlossene, die noch nicht gemeldet wurde.
+ * @param count    Anzahl der Requests.
+ * @param requests Feld mit count Requests.
+ * @param pending  Anzahl der ausstehenden Requests.
+ * @return Index der Request oder OSMP_UNDEFINED, wenn keine abgeschlossen ist.
+ */
+int find_oldest_completion(int count, const OSMP_Request *requests, int* pending) {
+    int oldest = OSMP_UNDEFINED;
+    *pending = 0;
+    for(int i = 0; i < count; i++) {
+        const IParams* params = (const IParams*)requests[i];
+        if(!is_pending_request(params)) {
+            continue;
+        }
+        (*pending)++;
+        if(__atomic_load_n(&params->done, __ATOMIC_ACQUIRE) == OSMP_DONE &&
+           (oldest == OSMP_UNDEFINED || params->completion < ((const IParams*)requests[oldest])->completion)) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
 
-    pthread_mutex_lock(&(params->mutex));
+/**
+ * Schläft, bis completion_count den Stand target erreicht hat. Der Aufrufer muss in completion_waiters eingetragen
+ * sein.
+ * @param target Gesuchter Stand von completion_count.
+ */
+void wait_for_completions(int target) {
+    while(1) {
+        // Erst die Schwelle eintragen, dann den Zähler lesen: Jede spätere Fertigstellung sieht die Schwelle
+        int wake_at = __atomic_load_n(&completion_wake_at, __ATOMIC_SEQ_CST);
+        while(!completions_reached(target, wake_at)
+              && !__atomic_compare_exchange_n(&completion_wake_at, &wake_at, target, 0, __ATOMIC_SEQ_CST,
+                                              __ATOMIC_SEQ_CST)) {
+        }
+        int seen = __atomic_load_n(&completion_count, __ATOMIC_SEQ_CST);
+        if(completions_reached(seen, target)) {
+            return;
+        }
+        osmp_wait_while_equal_private(&completion_count, seen);
+    }
+}
 
-    // Warte, bis Vorgang abgeschlossen ist
-    int status = params->done;
-    while(status == OSMP_WAITING) {
-        int result = pthread_cond_wait(&(params->convar), &(params->mutex));
-        if(result != 0) {
-            pthread_mutex_unlock(&(params->mutex));
-            return OSMP_FAILURE;
+/**
+ * Zählt die Requests, deren Operation noch läuft.
+ * @param count    Anzahl der Requests.
+ * @param requests Feld mit count Requests.
+ * @return Anzahl der laufenden Requests.
+ */
+int count_running_requests(int count, const OSMP_Request *requests) {
+    int running = 0;
+    for(int i = 0; i < count; i++) {
+        const IParams* params = (const IParams*)requests[i];
+        if(params != NULL && params->operation != REQUEST_IDLE
+           && __atomic_load_n(&params->done, __ATOMIC_ACQUIRE) != OSMP_DONE) {
+            running++;
         }
-        status = params->done;
     }
+    return running;
+}
 
-    pthread_mutex_unlock(&(params->mutex));
+int OSMP_Waitall(int count, OSMP_Request *requests) {
+    log_osmp_lib_call("OSMP_Waitall");
+    if(count < 0 || (requests == NULL && count > 0)) {
+        log_to_file(2, "Invalid array of requests.\n");
+        return OSMP_FAILURE;
+    }
 
+    // Statt auf jede Request einzeln wird einmal auf so viele Fertigstellungen gewartet, wie Requests laufen. Erst
+    // danach wird erneut gezählt, falls zwischenzeitlich Requests anderer Threads fertig wurden.
+    __atomic_add_fetch(&completion_waiters, 1, __ATOMIC_SEQ_CST);
+    while(1) {
+        int seen = __atomic_load_n(&completion_count, __ATOMIC_SEQ_CST);
+        int running = count_running_requests(count, requests);
+        if(running == 0) {
+            break;
+        }
+        wait_for_completions((int)((unsigned int)seen + (unsigned int)running));
+    }
+    __atomic_sub_fetch(&completion_waiters, 1, __ATOMIC_SEQ_CST);
     return OSMP_SUCCESS;
 }
 
-int OSMP_CreateRequest(OSMP_Request *request) {
-    log_osmp_lib_call("OSMP_CreateRequest");
-
-    if(request == NULL) {
-        log_to_file(3, "OSMP_Request was null!");
+int OSMP_Waitany(int count, OSMP_Request *requests, int *index) {
+    log_osmp_lib_call("OSMP_Waitany");
+    if(check_request_array(count, requests, index) != OSMP_SUCCESS) {
         return OSMP_FAILURE;
     }
 
-    // Allokiere Speicherplatz
-    IParams* params = calloc(1, sizeof(IParams));
-    if(params == NULL) {
-        log_to_file(3, "Couldn't calloc space for OSMP_Request");
-        return OSMP_FAILURE;
+    // Erst als Wartender eintragen, dann den Zähler lesen: Jede spätere Fertigstellung sieht den Eintrag und weckt
+    __atomic_add_fetch(&completion_waiters, 1, __ATOMIC_SEQ_CST);
+    int found, pending;
+    while(1) {
+        int seen = __atomic_load_n(&completion_count, __ATOMIC_SEQ_CST);
+        found = find_oldest_completion(count, requests, &pending);
+        if(found != OSMP_UNDEFINED || pending == 0) {
+            break;
+        }
+        wait_for_completions((int)((unsigned int)seen + 1));
     }
+    __atomic_sub_fetch(&completion_waiters, 1, __ATOMIC_SEQ_CST);
 
-    // Shared-Attribut für Mutex erzeugen
-    pthread_mutexattr_t att;
-    pthread_mutexattr_init(&att);
-    pthread_mutexattr_setpshared(&att, PTHREAD_PROCESS_SHARED);
-    // Mutex initialisieren
-    int result = pthread_mutex_init(&(params->mutex), &att);
-    if(result < 0){
-        log_to_file(3, "Couldn't init mutex for OSMP_Request");
-        free(params);
-        return OSMP_FAILURE;
+    if(found != OSMP_UNDEFINED) {
+        ((IParams*)requests[found])->reported = 1;
     }
-    // Lösche Attribut
-    pthread_mutexattr_destroy(&att);
+    *index = found;
+    return OSMP_SUCCESS;
+}
 
-    // Erzeuge Attribut für Condition-Variable
-    pthread_condattr_t condition_attr;
-    result = pthread_condattr_init(&condition_attr);
-    if(result < 0){
-        log_to_file(3, "Error on initiliazation of condition variable attribute for OSMP_Request");
+int OSMP_Testall(int count, OSMP_Request *requests, int *flag) {
+    log_osmp_lib_call("OSMP_Testall");
+    if(check_request_array(count, requests, flag) != OSMP_SUCCESS) {
         return OSMP_FAILURE;
     }
-    // Setze Attribut auf Shared
-    pthread_condattr_setpshared(&condition_attr, PTHREAD_PROCESS_SHARED);
-    // Initialisiere Condition-Variable
-    result = pthread_cond_init(&(params->convar), &condition_attr);
-    if(result < 0){
-        log_to_file(3, "Error on initialization of condition variable for OSMP_Request");
-        return OSMP_FAILURE;
+    *flag = OSMP_DONE;
+    for(int i = 0; i < count; i++) {
+        const IParams* params = (const IParams*)requests[i];
+        if(params != NULL && params->operation != REQUEST_IDLE
+           && __atomic_load_n(&params->done, __ATOMIC_ACQUIRE) != OSMP_DONE) {
+            *flag = OSMP_WAITING;
+            break;
+        }
     }
-    // Zerstöre Attribut für Condition-Variable
-    pthread_condattr_destroy(&condition_attr);
+    return OSMP_SUCCESS;
+}
 
-    // Setze Flag
-    params->done = OSMP_WAITING;
+int OSMP_Testsome(int count, OSMP_Request *requests, int *outcount, int *indices) {
+    log_osmp_lib_call("OSMP_Testsome");
+    if(check_request_array(count, requests, outcount) != OSMP_SUCCESS
+       || check_request_array(count, requests, indices) != OSMP_SUCCESS) {
+        return OSMP_FAILURE;
+    }
 
-    // caste auf opaken Datentypen und setze den oben übergebenen Pointer
-    *request = (OSMP_Request*) params;
+    int found = 0, pending = 0;
+    for(int i = 0; i < count; i++) {
+        IParams* params = (IParams*)requests[i];
+        if(!is_pending_request(params)) {
+            continue;
+        }
+        pending++;
+        if(__atomic_load_n(&params->done, __ATOMIC_ACQUIRE) != OSMP_DONE) {
+            continue;
+        }
+        // Nach Fertigstellungsnummer einsortieren, damit die Indizes in der Reihenfolge der Fertigstellung stehen
+        int position = found++;
+        while(position > 0 && ((IParams*)requests[indices[position - 1]])->completion > params->completion) {
+            indices[position] = indices[position - 1];
+            position--;
+        }
+        indices[position] = i;
+    }
+    for(int i = 0; i < found; i++) {
+        ((IParams*)requests[indices[i]])->reported = 1;
+    }
+    *outcount = pending == 0 ? OSMP_UNDEFINED : found;
     return OSMP_SUCCESS;
 }
 
-int OSMP_RemoveRequest(OSMP_Request *request) {
-    log_osmp_lib_call("OSMP_RemoveRequest");
+/**
+ * Liefert den Pfad, unter dem osmp_run den Shared Memory im hugetlbfs anlegt, wenn er mit Huge Pages hinterlegt wird.
+ * @param shared_memory_name Name des Shared Memory (siehe OSMP_GetSharedMemoryName()).
+ * @return Mit malloc() allozierter Pfad, der vom Aufrufer freigegeben werden muss.
+ */
+char* get_huge_page_path(const char* shared_memory_name) {
+    size_t length = strlen(HUGE_PAGE_MOUNT) + strlen(shared_memory_name) + 1;
+    char* path = malloc(length);
+    snprintf(path, length, "%s%s", HUGE_PAGE_MOUNT, shared_memory_name);
+    return path;
+}
 
-    if(request == NULL || *request == NULL) {
-        log_to_file(3, "OSMP_Request was null!");
-        return OSMP_FAILURE;
+/**
+ * Liefert die Länge, mit der eine Abbildung des Shared Memory wieder freigegeben wird. Ist er mit Huge Pages
+ * hinterlegt, verlangt munmap() ganze Huge Pages.
+ * @param size       Größe der Abbildung in Bytes.
+ * @param huge_pages 1, wenn der Shared Memory im hugetlbfs liegt, sonst 0.
+ * @return Länge der Abbildung in Bytes.
+ */
+size_t get_mapping_length(size_t size, int huge_pages) {
+    if(!huge_pages) {
+        return size;
     }
+    return (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
 
-    // Caste opaken Datentypen auf unser internes Struct
-    IParams* params = (IParams*)*request;
-
-    // Zerstöre Mutex
-    int result = pthread_mutex_destroy(&(params->mutex));
-    if(result != 0) {
-        log_to_file(3, "Couldn't destroy mutex in OSMP_Request");
+int OSMP_GetEventFd(int *fd) {
+    log_osmp_lib_call("OSMP_GetEventFd");
+    if(fd == NULL) {
+        log_to_file(2, "Output parameter must not be null.\n");
         return OSMP_FAILURE;
     }
-
-    // Zerstöre Condition-Variable
-    result = pthread_cond_destroy(&(params->convar));
-    if(result != 0) {
-        log_to_file(3, "Couldn't destroy condition variable in OSMP_Request");
+    // Das Eventfd und sein Überwachungsthread werden beim ersten Aufruf angelegt
+    pthread_mutex_lock(&event_mutex);
+    if(event_fd == -1) {
+        event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if(event_fd == -1) {
+            pthread_mutex_unlock(&event_mutex);
+            log_to_file(3, "Couldn't create eventfd.\n");
+            return OSMP_FAILURE;
+        }
+        if(pthread_create(&event_thread, NULL, OSMP_thread_event, NULL) != 0) {
+            close(event_fd);
+            event_fd = -1;
+            pthread_mutex_unlock(&event_mutex);
+            log_to_file(3, "pthread_create failed");
+            return OSMP_FAILURE;
+        }
     }
+    pthread_mutex_unlock(&event_mutex);
 
-    free(params);
+    process_info* info = get_process_info(OSMP_rank);
+    // Erst scharf schalten, dann prüfen: Jede spätere Nachricht sieht das Flag und meldet sich selbst
+    __atomic_store_n(&info->event_armed, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&pending_mutex);
+    int waiting = arrival_first != NULL;
+    pthread_mutex_unlock(&pending_mutex);
+    if(waiting || __atomic_load_n(&info->postbox.sem_proc_full.value, __ATOMIC_SEQ_CST) > 0) {
+        signal_event(OSMP_rank);
+    }
+    *fd = event_fd;
     return OSMP_SUCCESS;
 }
 
@@ -3,8 +3,10 @@
 #include <stdio.h>
 #include <pthread.h>
 #include <semaphore.h>
+#include <stdint.h>
 
 #include "OSMP.h"
+#include "osmp_sync.h"
 
 /**
  * Dieses Makro wird verwendet, um den Compiler davon zu überzeugen, dass eine Variable verwendet wird.
@@ -57,16 +59,279 @@
  */
 #define AVAILABLE 0
 
+/**
+ * Setzt den Kopf eines Stapels mit Versionszähler aus Zähler (obere 32 Bit) und Index (untere 32 Bit) zusammen.
+ */
+#define TAGGED_HEAD(tag, index) (((uint64_t)(tag) << 32) | (uint32_t)(index))
+
+/**
+ * Liefert den Index aus dem Kopf eines Stapels mit Versionszähler.
+ */
+#define TAGGED_HEAD_INDEX(head) ((int)(uint32_t)(head))
+
+/**
+ * Liefert den Versionszähler aus dem Kopf eines Stapels mit Versionszähler.
+ */
+#define TAGGED_HEAD_TAG(head) ((uint32_t)((head) >> 32))
+
+/**
+ * Anzahl der Größenklassen des Heaps im Shared Memory.
+ */
+#define HEAP_CLASSES 5
+
+/**
+ * Blockgrößen der Größenklassen in Bytes (aufsteigend). Die größte genutzte Klasse wird auf die maximale Nutzlast
+ * gesetzt; Klassen oberhalb der maximalen Nutzlast entfallen.
+ */
+#define HEAP_CLASS_SIZES {64, 256, 4096, 65536, 0}
+
+/**
+ * Anzahl der Blöcke je Größenklasse; 0 steht für so viele Blöcke, wie es Nachrichtenslots gibt. Jede Klasse erhält
+ * mindestens einen Block pro Prozess, damit jedem Sender ein Block reserviert werden kann.
+ */
+#define HEAP_CLASS_COUNTS {0, 0, 64, 16, 4}
+
+/**
+ * Anzahl der Teilstücke einer großen Nachricht, die gleichzeitig unterwegs sein dürfen.
+ */
+#define CHUNK_DEPTH 4
+
+/**
+ * Ab dieser Länge in Bytes legt OSMP_Send() für Nachrichten oberhalb der maximalen Nutzlast nur einen Deskriptor ins
+ * Postfach, und der Empfänger liest die Nachricht per process_vm_readv() direkt aus dem Adressraum des Senders.
+ * Nachrichten, die in einen Nachrichtenslot passen, werden immer gepuffert gesendet, damit OSMP_Send() für sie nicht
+ * auf den Empfänger wartet.
+ */
+#define RENDEZVOUS_THRESHOLD (64 * 1024)
+
+/**
+ * Zustand eines Heap-Blocks, dessen Nachricht versendet wurde und im Postfach liegt oder empfangen wird.
+ */
+#define BLOCK_QUEUED 0
+
+/**
+ * Zustand eines Heap-Blocks, den OSMP_SendAlloc() geliefert hat und der noch nicht mit OSMP_SendCommit() versendet
+ * wurde.
+ */
+#define BLOCK_SEND_ALLOCATED 1
+
+/**
+ * Zustand eines Heap-Blocks, den OSMP_RecvBorrow() geliefert hat und der noch nicht mit OSMP_RecvRelease() freigegeben
+ * wurde.
+ */
+#define BLOCK_BORROWED 2
+
+/**
+ * Anzahl der Zustände eines Heap-Blocks.
+ */
+#define BLOCK_STATES 3
+
+/**
+ * Eintrag der Block-Zuordnung eines Heaps für einen Block, der dem angegebenen Nachrichtenslot im angegebenen Zustand
+ * gehört.
+ */
+#define BLOCK_OWNER(slot_index, state) ((slot_index) * BLOCK_STATES + (state))
+
+/**
+ * Liefert den Nachrichtenslot aus einem Eintrag der Block-Zuordnung.
+ */
+#define BLOCK_OWNER_SLOT(owner) ((owner) / BLOCK_STATES)
+
+/**
+ * Anzahl der Rendezvous-Deskriptoren pro Prozess, also der gleichzeitig laufenden Rendezvous-Sendungen eines Prozesses.
+ */
+#define RENDEZVOUS_DESCRIPTORS 4
+
+/**
+ * Postfach-Einträge ab der Anzahl der Nachrichtenslots verweisen nicht auf einen Nachrichtenslot, sondern auf einen
+ * Rendezvous-Deskriptor.
+ */
+#define RENDEZVOUS_MESSAGE(slots, rank, index) ((slots) + (rank) * RENDEZVOUS_DESCRIPTORS + (index))
+
+/**
+ * Der Rendezvous-Deskriptor wartet darauf, dass der Empfänger die Nachricht liest.
+ */
+#define RENDEZVOUS_PENDING 0
+
+/**
+ * Der Empfänger hat die Nachricht aus dem Adressraum des Senders gelesen.
+ */
+#define RENDEZVOUS_DONE 1
+
+/**
+ * Der Empfänger konnte nicht auf den Adressraum des Senders zugreifen; der Sender muss die Nachricht über einen
+ * Nachrichtenslot schicken.
+ */
+#define RENDEZVOUS_REJECTED 2
+
+/**
+ * Der Prozess hat keinen Empfangspuffer bereitgestellt.
+ */
+#define POSTED_IDLE 0
+
+/**
+ * Der Empfangspuffer ist bereitgestellt und kann von einem Sender belegt werden.
+ */
+#define POSTED_OPEN 1
+
+/**
+ * Ein Sender hat den Empfangspuffer belegt und entscheidet, ob er direkt hineinschreibt.
+ */
+#define POSTED_CLAIMED 2
+
+/**
+ * Ein Sender hat die Nachricht in den Empfangspuffer geschrieben; ein DIRECT_ENTRY im Postfach folgt.
+ */
+#define POSTED_FILLED 3
+
+/**
+ * Für den Prozess liegt kein ungemeldetes Ereignis vor; der Überwachungsthread seines Eventfds wartet.
+ */
+#define EVENT_IDLE 0
+
+/**
+ * Ein Ereignis wurde gemeldet, aber noch nicht an das Eventfd weitergegeben. Weitere Ereignisse bis dahin werden
+ * zusammengefasst.
+ */
+#define EVENT_PENDING 1
+
+/**
+ * Der Überwachungsthread des Eventfds soll sich beenden.
+ */
+#define EVENT_STOP 2
+
+/**
+ * Kennzeichnet einen Nachrichtenslot, der nicht aus der Reservierung eines Senders, sondern aus dem gemeinsamen Vorrat
+ * stammt.
+ */
+#define SHARED_CREDIT (-1)
+
+/**
+ * Der Anteil 1/SLOT_RESERVE_SHARE der Nachrichtenslots wird gleichmäßig auf die Sender reserviert; die übrigen Slots
+ * bilden den gemeinsamen Vorrat.
+ */
+#define SLOT_RESERVE_SHARE 2
+
+/**
+ * Nachrichten bis zu dieser Länge in Bytes legt der Sender direkt in den Postfach-Eintrag, ohne einen Nachrichtenslot
+ * zu belegen. Kopf und Nutzlast eines solchen Eintrags füllen genau eine Cache-Line.
+ */
+#define INLINE_PAYLOAD_LENGTH 40
+
+/**
+ * Kennzeichnet einen Postfach-Eintrag, der die Nachricht selbst enthält.
+ */
+#define INLINE_ENTRY (-2)
+
+/**
+ * Kennzeichnet einen Postfach-Eintrag, dessen Nachricht der Sender bereits direkt in den vorab bereitgestellten
+ * Empfangspuffer geschrieben hat (siehe posted_receive).
+ */
+#define DIRECT_ENTRY (-3)
+
+/**
+ * Der Zwischenspeicher für Inline-Nachrichten kann nicht mehr wachsen. Die nächste Nachricht bleibt im Postfach, bis
+ * Empfangsaufrufe Einträge freigegeben haben.
+ */
+#define INLINE_EXHAUSTED (-4)
+
+/**
+ * Anzahl der Inline-Nachrichten, die der Empfänger gemeinsam in einem Block seines Zwischenspeichers anlegt.
+ */
+#define INLINE_BLOCK_SIZE 256
+
+/**
+ * Höchstzahl der Blöcke im Zwischenspeicher für Inline-Nachrichten eines Empfängers.
+ */
+#define INLINE_BLOCKS 16384
+
+/**
+ * Die Request wurde noch für keine Operation verwendet.
+ */
+#define REQUEST_IDLE 0
+
+/**
+ * Die Request gehört zu einem Senden (OSMP_ISend() oder OSMP_Send_init()).
+ */
+#define REQUEST_SEND 1
+
+/**
+ * Die Request gehört zu einem Empfangen (OSMP_IRecv() oder OSMP_Recv_init()).
+ */
+#define REQUEST_RECV 2
+
+/**
+ * Höchstzahl der Hilfsthreads der Progress-Engine eines Prozesses, unabhängig von der Anzahl der Prozesse.
+ * Höchstens PROGRESS_THREADS - 1 davon führen gleichzeitig blockierende Operationen aus (Empfänge und Sendungen in
+ * Teilstücken oder per Rendezvous), damit immer ein Thread für die übrigen Sendungen frei bleibt.
+ */
+#define PROGRESS_THREADS 4
+
+/**
+ * Wartezeit in Mikrosekunden, nach der ein Hilfsthread der Progress-Engine es erneut versucht, wenn in einer Runde
+ * über alle bereiten Warteschlangen keine Request vorankam.
+ */
+#define PROGRESS_BACKOFF_US 50
+
+/**
+ * Abstand, um den die Weckschwelle für Fertigstellungen nach dem Wecken in die Zukunft gelegt wird. Bis ein
+ * Wartender eine neue Schwelle einträgt, weckt dann keine Fertigstellung.
+ */
+#define COMPLETION_NO_TARGET 0x40000000
+
+/**
+ * Anzahl der Requests, die ein Prozess gemeinsam in einem Block seines Request-Pools anlegt.
+ */
+#define REQUEST_BLOCK_SIZE 256
+
+/**
+ * Höchstzahl der Blöcke im Request-Pool eines Prozesses.
+ */
+#define REQUEST_BLOCKS 4096
+
+/**
+ * Ausrichtung der Bereiche im Shared Memory in Bytes (Größe einer Cache-Line).
+ */
+#define CACHE_LINE_SIZE 64
+
+/**
+ * Richtet einen Typ oder ein Struct-Element am Beginn einer Cache-Line aus. Felder, die von verschiedenen Prozessen
+ * geschrieben werden, liegen so nicht in derselben Cache-Line (False Sharing).
+ */
+#define CACHE_ALIGNED __attribute__((aligned(CACHE_LINE_SIZE)))
+
+/**
+ * Obergrenze für die Anzahl der Nachrichtenslots und die Tiefe der Postfächer, die osmp_run akzeptiert.
+ */
+#define MAX_CONFIGURABLE_COUNT 65536
+
+/**
+ * Obergrenze für die maximale Nutzlast in Bytes, die osmp_run akzeptiert.
+ */
+#define MAX_CONFIGURABLE_PAYLOAD (256 * 1024 * 1024)
+
 /**
  * Maximal erlaubte Länge des Pfads zur Logdatei, inkl. terminierendem Nullbyte.
  */
 #define MAX_PATH_LENGTH 256
 
+/**
+ * Einhängepunkt des hugetlbfs, in dem osmp_run den Shared Memory auf Wunsch (-H) mit Huge Pages anlegt.
+ */
+#define HUGE_PAGE_MOUNT "/dev/hugepages"
+
+/**
+ * Größe einer Huge Page in Bytes; die Größe des Shared Memory wird im hugetlbfs auf ein Vielfaches davon aufgerundet.
+ */
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
 /**
  * @struct message_slot
- * @brief Struct für eine Nachricht entsprechend der Definition unseres Shared Memory.
+ * @brief Struct für eine Nachricht entsprechend der Definition unseres Shared Memory. Die Köpfe aller Slots liegen
+ * zusammen in einem Array, getrennt von den Inhalten im Heap; jeder Kopf belegt eine eigene Cache-Line, damit
+ * gleichzeitige Sendungen über benachbarte Slots sich nicht gegenseitig verdrängen.
  */
-typedef struct message_slot {
+typedef struct CACHE_ALIGNED message_slot {
     /**
      * @var from
      * Rang des sendenden Prozesses.
@@ -79,6 +344,12 @@ typedef struct message_slot {
      */
     int len;
 
+    /**
+     * @var dest
+     * Rang des empfangenden Prozesses.
+     */
+    int dest;
+
     /**
      * @var type
      * Datentyp der enthaltenen Nachricht
@@ -86,71 +357,282 @@ typedef struct message_slot {
     OSMP_Datatype type;
 
     /**
-     * @var payload
-     * Inhalt der Nachricht.
+     * @var tag
+     * Tag der Nachricht.
+     */
+    int tag;
+
+    /**
+     * @var heap_class
+     * Größenklasse des Heap-Blocks, der den Inhalt der Nachricht enthält.
+     */
+    int heap_class;
+
+    /**
+     * @var block
+     * Index des Heap-Blocks innerhalb seiner Größenklasse, der den Inhalt der Nachricht enthält.
+     */
+    int block;
+
+    /**
+     * @var credit_owner
+     * Rang des Senders, aus dessen Reservierung der Slot stammt, oder SHARED_CREDIT.
+     */
+    int credit_owner;
+
+    /**
+     * @var block_owner
+     * Rang des Senders, aus dessen Reservierung der Heap-Block stammt, oder SHARED_CREDIT.
      */
-    char payload[OSMP_MAX_PAYLOAD_LENGTH];
+    int block_owner;
+
+    /**
+     * @var sem_chunks_full
+     * Semaphore für gefüllte Teilstücke einer großen Nachricht.
+     */
+    osmp_sem sem_chunks_full;
+
+    /**
+     * @var sem_chunks_empty
+     * Semaphore für freie Plätze im Ringpuffer der Teilstücke.
+     */
+    osmp_sem sem_chunks_empty;
 } message_slot;
 
-typedef struct {
+/**
+ * @struct heap_class
+ * @brief Verwaltung einer Größenklasse des Heaps im Shared Memory. Die Blöcke einer Klasse haben alle dieselbe Größe
+ * und werden wie die Nachrichtenslots über einen lock-freien Stapel vergeben. Jede Klasse belegt eine eigene
+ * Cache-Line.
+ */
+typedef struct CACHE_ALIGNED heap_class {
     /**
-     * @var postbox
-     * Array, das alle Nachrichten für den Prozess enthält (als Index des Nachrichtenslots).
+     * @var block_size
+     * Größe eines Blocks in Bytes.
      */
-    int postbox[OSMP_MAX_MESSAGES_PROC];
+    int block_size;
 
     /**
-     * @var in_index
-     * Index, der auf den nächsten freien Platz im Postfach zeigt.
+     * @var block_count
+     * Anzahl der Blöcke dieser Klasse.
      */
-    int in_index;
+    int block_count;
 
     /**
-     * @var mutex_proc_in
-     * Mutex für die Synchronisierung der in_index-Variable.
+     * @var reserved_blocks
+     * Anzahl der Blöcke, die jedem Prozess als Sender reserviert sind (siehe process_info.sem_heap_credits).
      */
-    pthread_mutex_t mutex_proc_in;
+    int reserved_blocks;
 
     /**
-     * @var out_index
-     * Index, der auf die nächste Nachricht im Postfach zeigt.
+     * @var next_offset
+     * Offset (ab Beginn des Shared Memory) des int-Arrays, das die freien Blöcke verkettet.
+     */
+    size_t next_offset;
+
+    /**
+     * @var owner_offset
+     * Offset (ab Beginn des Shared Memory) des int-Arrays, das zu jedem Block den Nachrichtenslot, dem er gehört, und
+     * seinen Zustand enthält (siehe BLOCK_OWNER), oder NO_SLOT für einen freien Block.
+     */
+    size_t owner_offset;
+
+    /**
+     * @var blocks_offset
+     * Offset (ab Beginn des Shared Memory) des ersten Blocks.
+     */
+    size_t blocks_offset;
+
+    /**
+     * @var free_blocks
+     * Kopf des Stapels der freien Blöcke (siehe shared_memory.free_slots).
+     */
+    uint64_t free_blocks;
+
+    /**
+     * @var sem_free_blocks
+     * Semaphore für den gemeinsamen Vorrat an Blöcken dieser Klasse, die nicht für einzelne Sender reserviert sind.
+     */
+    osmp_sem sem_free_blocks;
+} heap_class;
+
+/**
+ * @struct postbox_entry
+ * @brief Ein Eintrag im Ringpuffer eines Postfachs.
+ */
+typedef struct CACHE_ALIGNED postbox_entry {
+    /**
+     * @var sequence
+     * Sequenznummer des Eintrags. Steht auf der Position des schreibenden Senders, solange der Eintrag frei ist, und
+     * auf Position + 1, sobald die Nachricht veröffentlicht wurde. Der Empfänger setzt sie nach dem Lesen auf
+     * Position + Tiefe des Postfachs, womit der Eintrag für die nächste Runde frei wird.
+     */
+    uint64_t sequence;
+
+    /**
+     * @var slot
+     * Index des Nachrichtenslots, der die Nachricht enthält, oder INLINE_ENTRY, wenn sie im Eintrag selbst liegt.
+     */
+    int slot;
+
+    /**
+     * @var from
+     * Rang des Senders einer Inline-Nachricht.
+     */
+    int from;
+
+    /**
+     * @var tag
+     * Tag einer Inline-Nachricht.
+     */
+    int tag;
+
+    /**
+     * @var len
+     * Länge einer Inline-Nachricht in Bytes.
+     */
+    int len;
+
+    /**
+     * @var payload
+     * Nutzlast einer Inline-Nachricht.
      */
-    int out_index;
+    char payload[INLINE_PAYLOAD_LENGTH];
+} postbox_entry;
 
+/**
+ * @struct postbox_utilities
+ * @brief Lock-freier Ringpuffer (mehrere Sender, ein Empfänger) für die Nachrichten eines Prozesses.
+ * Sender und Empfänger reservieren ihre Position per atomarem Inkrement; die Semaphoren blockieren nur, wenn der
+ * Ring tatsächlich voll bzw. leer ist. Die Einträge des Rings liegen hinter den Nachrichtenslots im Shared Memory,
+ * da ihre Anzahl erst beim Start von osmp_run festgelegt wird.
+ */
+typedef struct {
     /**
-     * @var mutex_proc_out
-     * Mutex für die Synchronisierung der out_index-Variable.
+     * @var in_index
+     * Monoton steigende Schreibposition; wird von den Sendern atomar inkrementiert. Liegt zusammen mit
+     * sem_proc_empty in der Cache-Line der Sender.
      */
-    pthread_mutex_t mutex_proc_out;
+    uint64_t in_index CACHE_ALIGNED;
 
     /**
      * @var sem_proc_empty
-     * Semaphore für freie Plätze im Postfach.
+     * Semaphore für freie Plätze im Postfach; die Sender warten auf sie.
+     */
+    osmp_sem sem_proc_empty;
+
+    /**
+     * @var out_index
+     * Monoton steigende Leseposition; wird vom Empfänger atomar inkrementiert. Liegt zusammen mit sem_proc_full
+     * in der Cache-Line des Empfängers.
      */
-    sem_t sem_proc_empty;
+    uint64_t out_index CACHE_ALIGNED;
 
     /**
      * @var sem_proc_full
-     * Semaphore für belegte Plätze im Postfach.
+     * Semaphore für belegte Plätze im Postfach; der Empfänger wartet auf sie.
      */
-    sem_t sem_proc_full;
+    osmp_sem sem_proc_full;
+} postbox_utilities;
 
+/**
+ * @struct rendezvous_descriptor
+ * @brief Beschreibt eine Nachricht, die der Empfänger direkt aus dem Adressraum des Senders liest. Jeder Deskriptor
+ * belegt eine eigene Cache-Line.
+ */
+typedef struct CACHE_ALIGNED rendezvous_descriptor {
     /**
-     * @var sem_proc_full_counter
-     * A number representing the value of the semaphore.
+     * @var in_use
+     * Flag, das anzeigt, dass der Deskriptor von einer laufenden Sendung belegt ist.
      */
-     int sem_proc_full_value;
+    int in_use;
 
     /**
-    * @var sem_proc_full_value_mutex
-    * Mutex für die Synchronisierung der sem_proc_full_value Variable.
-    */
-     pthread_mutex_t sem_proc_full_value_mutex;
-} postbox_utilities;
+     * @var len
+     * Länge der Nachricht in Bytes.
+     */
+    int len;
+
+    /**
+     * @var type
+     * OSMP-Typ der Nachricht.
+     */
+    OSMP_Datatype type;
+
+    /**
+     * @var tag
+     * Tag der Nachricht.
+     */
+    int tag;
+
+    /**
+     * @var status
+     * RENDEZVOUS_PENDING, RENDEZVOUS_DONE oder RENDEZVOUS_REJECTED.
+     */
+    int status;
+
+    /**
+     * @var address
+     * Adresse der Nachricht im Adressraum des Senders.
+     */
+    uint64_t address;
+
+    /**
+     * @var sem_done
+     * Semaphore, mit der der Empfänger dem Sender das Ende des Lesens meldet.
+     */
+    osmp_sem sem_done;
+} rendezvous_descriptor;
+
+/**
+ * @struct posted_receive
+ * @brief Beschreibt einen Empfangspuffer, den ein Prozess für sein nächstes OSMP_IRecv() bereitstellt. Ein Sender, der
+ * ihn belegt, schreibt die Nachricht per process_vm_writev() direkt hinein, statt sie über einen Nachrichtenslot zu
+ * schicken.
+ */
+typedef struct CACHE_ALIGNED posted_receive {
+    /**
+     * @var state
+     * POSTED_IDLE, POSTED_OPEN, POSTED_CLAIMED oder POSTED_FILLED.
+     */
+    int state;
+
+    /**
+     * @var capacity
+     * Größe des Empfangspuffers in Bytes.
+     */
+    int capacity;
+
+    /**
+     * @var source
+     * Rang des Senders, der die Nachricht geschrieben hat.
+     */
+    int source;
+
+    /**
+     * @var tag
+     * Tag der geschriebenen Nachricht.
+     */
+    int tag;
+
+    /**
+     * @var len
+     * Länge der geschriebenen Nachricht in Bytes.
+     */
+    int len;
+
+    /**
+     * @var address
+     * Adresse des Empfangspuffers im Adressraum des Empfängers.
+     */
+    uint64_t address;
+} posted_receive;
 
 /**
  * @struct process_info
- * @brief Struct für Informationen zu einem Prozess
+ * @brief Struct für Informationen zu einem Prozess. Die selten geschriebenen Felder liegen vorn; Postfach, Gather-Slot,
+ * Rendezvous-Deskriptoren und bereitgestellter Empfangspuffer beginnen jeweils auf einer eigenen Cache-Line, sodass
+ * auch die Infos benachbarter Ränge keine Cache-Line teilen.
  */
 typedef struct process_info {
     /**
@@ -165,6 +647,47 @@ typedef struct process_info {
      */
     int pid;
 
+    /**
+     * @var cpu
+     * CPU, an die osmp_run den Prozess gebunden hat (osmp_run -A), sonst -1.
+     */
+    int cpu;
+
+    /**
+     * @var available
+     * Ein Flag um zu wiesen, ob dieser Prozess verfügbar ist.
+     */
+    int available;
+
+    /**
+     * @var event_armed
+     * 1, sobald der Prozess sein Eventfd mit OSMP_GetEventFd() abgefragt hat. Erst dann melden Sender und
+     * abgeschlossene Requests Ereignisse über event_pending.
+     */
+    int event_armed;
+
+    /**
+     * @var event_pending
+     * Futex-Wort, über das Sender dem Überwachungsthread des Prozesses ein Ereignis melden (EVENT_IDLE,
+     * EVENT_PENDING oder EVENT_STOP). Der Überwachungsthread signalisiert daraufhin das prozesslokale Eventfd.
+     */
+    int event_pending;
+
+    /**
+     * @var sem_credits
+     * Reservierte Nachrichtenslots, die der Prozess als Sender noch belegen darf. Die Empfänger geben sie beim
+     * Freigeben der Slots zurück.
+     */
+    osmp_sem sem_credits CACHE_ALIGNED;
+
+    /**
+     * @var sem_heap_credits
+     * Reservierte Heap-Blöcke je Größenklasse, die der Prozess als Sender noch belegen darf. Zusammen mit sem_credits
+     * garantieren sie, dass ein Sender auch dann weitersenden kann, wenn andere Sender den gemeinsamen Vorrat einer
+     * Größenklasse aufgebraucht haben.
+     */
+    osmp_sem sem_heap_credits[HEAP_CLASSES];
+
     /**
      * @var postbox
      * Postfach des Prozesses.
@@ -173,31 +696,43 @@ typedef struct process_info {
 
     /**
      * @var gather_slot
-     * Der Gather-Slot des Prozesses.
+     * Der Gather-Slot des Prozesses. Verweist auf den Heap-Block mit dem Beitrag des Prozesses.
      */
     message_slot gather_slot;
 
     /**
-     * @var available
-     * Ein Flag um zu wiesen, ob dieser Prozess verfügbar ist.
+     * @var gather_ready
+     * Flag, das anzeigt, dass der Beitrag im Gather-Slot vom Root-Prozess gelesen werden kann.
      */
-    int available;
+    int gather_ready;
+
+    /**
+     * @var rendezvous
+     * Deskriptoren der Rendezvous-Sendungen dieses Prozesses.
+     */
+    rendezvous_descriptor rendezvous[RENDEZVOUS_DESCRIPTORS];
+
+    /**
+     * @var posted
+     * Vorab bereitgestellter Empfangspuffer dieses Prozesses.
+     */
+    posted_receive posted;
 } process_info;
 
 /**
  * @struct barrier_t
  * @brief Datentyp zur Beschreibung einer Barriere. */
 typedef struct barrier_t {
-    pthread_mutex_t mutex; /* Zugriffskontrolle */
-    pthread_cond_t convar; /* Warten auf Barriere */
     int valid; /* gesetzt, wenn Barriere initalisiert */
-    int counter; /* Threads zaehlen */
-    int cycle; /* Flag ob Barriere aktiv ist */
+    int counter; /* Prozesse zaehlen */
+    int cycle; /* Zyklusnummer, dient zugleich als Futex-Wort */
 } barrier_t;
 
 /**
  * @struct shared_memory
- * @brief Struct für den fixen Teil des Shared Memory gemäß unserer Spezifikation.
+ * @brief Struct für den fixen Teil des Shared Memory gemäß unserer Spezifikation. Vorn liegt die nach dem Start nur
+ * noch gelesene Konfiguration; Felder, die im laufenden Betrieb von mehreren Prozessen geschrieben werden, beginnen
+ * jeweils auf einer eigenen Cache-Line.
  */
 typedef struct shared_memory {
     /**
@@ -206,6 +741,54 @@ typedef struct shared_memory {
      */
     int size;
 
+    /**
+     * @var max_slots
+     * Anzahl der Nachrichtenslots (osmp_run -S, sonst OSMP_MAX_SLOTS).
+     */
+    int max_slots;
+
+    /**
+     * @var max_messages_proc
+     * Tiefe der Postfächer (osmp_run -Q, sonst OSMP_MAX_MESSAGES_PROC).
+     */
+    int max_messages_proc;
+
+    /**
+     * @var max_payload_length
+     * Maximale Nutzlast eines Nachrichtenslots in Bytes (osmp_run -P, sonst OSMP_MAX_PAYLOAD_LENGTH).
+     */
+    int max_payload_length;
+
+    /**
+     * @var reserved_slots
+     * Anzahl der Nachrichtenslots, die für jeden Sender reserviert sind (siehe SLOT_RESERVE_SHARE).
+     */
+    int reserved_slots;
+
+    /**
+     * @var heap_classes
+     * Anzahl der genutzten Größenklassen des Heaps.
+     */
+    int heap_classes;
+
+    /**
+     * @var verbosity
+     * Logging-Verbosität.
+     */
+    unsigned int verbosity;
+
+    /**
+     * @var spin_budget
+     * Maximale Anzahl aktiver Warterunden, bevor ein Prozess an einer blockierenden Stelle schlafen gelegt wird.
+     */
+    int spin_budget;
+
+    /**
+     * @var logfile
+     * Pfad zur Logdatei.
+     */
+    char logfile[MAX_PATH_LENGTH];
+
     /**
      * @var logging_mutex
      * Mutex für den Zugriff auf die Logdatei.
@@ -218,41 +801,35 @@ typedef struct shared_memory {
      */
     pthread_mutex_t initializing_mutex;
 
-    /**
-     * @var initializing_condition
-     * Ein Condition für das Warten bis ein Prozess initialisiert würde.
-     */
-    pthread_cond_t initializing_condition;
-
     /**
      * @var free_slots
-     * Liste der freien Nachrichtenslots.
+     * Kopf des lock-freien Stapels (Treiber-Stack) der freien Nachrichtenslots. Die unteren 32 Bit enthalten den
+     * Index des obersten freien Slots (oder NO_SLOT), die oberen 32 Bit einen Zähler, der bei jeder Änderung erhöht
+     * wird und so das ABA-Problem verhindert. Beginnt zusammen mit sem_shm_free_slots eine eigene Cache-Line, da alle
+     * Sender darauf zugreifen.
      */
-    int free_slots[OSMP_MAX_SLOTS];
-
-    /**
-     * @var free_slots_index
-     * Zeigt auf die Stelle in free_slots, an der das nächste freie Postfach liegt.
-     */
-    int free_slots_index;
+    uint64_t free_slots CACHE_ALIGNED;
 
     /**
      * @var sem_shm_free_slots;
-     * Semaphore für die Vergabe von Nachrichtenslots.
+     * Semaphore für die Vergabe der Nachrichtenslots des gemeinsamen Vorrats. Die für die Sender reservierten Slots
+     * werden über process_info.sem_credits vergeben; beide zusammen zählen die Slots im Stapel free_slots.
      */
-    sem_t sem_shm_free_slots;
+    osmp_sem sem_shm_free_slots;
 
     /**
-     * @var mutex_shm_free_slots
-     * Mutex zur Synchronisierung des Zugriffs auf die Liste der freien Nachrichtenslots und deren Index.
+     * @var heap
+     * Größenklassen des Heaps, der die Inhalte aller Nachrichten enthält. Die Blöcke liegen hinter den
+     * Postfach-Einträgen am Ende des Shared Memory.
      */
-    pthread_mutex_t mutex_shm_free_slots;
+    heap_class heap[HEAP_CLASSES];
 
     /**
-     * @var slots
-     * Array mit allen 1:1-Nachrichtenslots.
+     * @var sem_gather
+     * Semaphore, über die der Gather-Root-Prozess über bereitliegende Beiträge benachrichtigt wird. Beginnt zusammen
+     * mit gather_mutex eine eigene Cache-Line.
      */
-    message_slot slots[OSMP_MAX_SLOTS];
+    osmp_sem sem_gather CACHE_ALIGNED;
 
     /**
      * @var gather_mutex
@@ -262,72 +839,215 @@ typedef struct shared_memory {
 
     /**
      * @var barrier
-     * Barriere.
+     * Barriere. Liegt auf einer eigenen Cache-Line.
      */
-    barrier_t barrier;
+    barrier_t barrier CACHE_ALIGNED;
 
     /**
-     * @var logfile
-     * Pfad zur Logdatei.
+     * @var process_info
+     * Info zu Prozess 0. Speicher für weitere Prozess-Infos muss über die fixe Struct-Größe hinaus
+     * dynamisch berechnet werden. Dahinter folgen die Bereiche, deren Größe von der Konfiguration abhängt
+     * (siehe memory_offsets).
      */
-    char logfile[MAX_PATH_LENGTH];
+    process_info first_process_info;
+} shared_memory;
 
+/**
+ * @struct memory_offsets
+ * @brief Offsets (ab Beginn des Shared Memory) der Bereiche, deren Größe von der Anzahl der Prozesse, der
+ * Nachrichtenslots und der Tiefe der Postfächer abhängt. Jeder Prozess berechnet sie selbst aus den Werten im
+ * fixen Teil des Shared Memory.
+ */
+typedef struct memory_offsets {
     /**
-     * @var verbosity
-     * Logging-Verbosität.
+     * @var next_free_slot
+     * Verkettung der freien Nachrichtenslots (ein int pro Slot): Für jeden freien Slot der Index des
+     * darunterliegenden freien Slots.
      */
-    unsigned int verbosity;
+    size_t next_free_slot;
 
     /**
-     * @var process_info
-     * Info zu Prozess 0. Speicher für weitere Prozess-Infos muss über die fixe Struct-Größe hinaus
-     * dynamisch berechnet werden.
+     * @var slots
+     * Köpfe aller 1:1-Nachrichtenslots (ein message_slot pro Slot).
      */
-    process_info first_process_info;
-} shared_memory;
+    size_t slots;
+
+    /**
+     * @var postbox_entries
+     * Einträge der Postfächer aller Prozesse; das Postfach von Rang r beginnt r * postbox_stride Bytes dahinter.
+     */
+    size_t postbox_entries;
+
+    /**
+     * @var postbox_stride
+     * Abstand der Postfächer zweier benachbarter Ränge in Bytes, aufgerundet auf eine ganze Cache-Line.
+     */
+    size_t postbox_stride;
+
+    /**
+     * @var heap
+     * Beginn des Heaps.
+     */
+    size_t heap;
+} memory_offsets;
 
 /**
- * @struct thread_node
- * @brief Eine two way linked list von threads,
+ * @struct progress_queue
+ * @brief Warteschlange der Progress-Engine. Jeder Empfänger hat eine Warteschlange für die nicht blockierenden
+ * Sendungen an ihn, alle nicht blockierenden Empfänge teilen sich eine weitere. Die Hilfsthreads des gemeinsamen
+ * Pools bedienen die Warteschlangen reihum und führen von jeder immer nur die älteste Request aus, sodass die
+ * Reihenfolge pro Warteschlange erhalten bleibt. Alle Felder werden durch progress_mutex geschützt.
  */
-typedef struct thread_node{
+typedef struct progress_queue {
+    /**
+     * @var first
+     * @brief Älteste wartende Request.
+     */
+    struct IParams * first;
 
     /**
-     * @var thread
-     * @brief Der Thread in diesem Knoten.
+     * @var last
+     * @brief Jüngste wartende Request.
      */
-    pthread_t thread;
+    struct IParams * last;
 
     /**
-     * @var next
-     * @brief Ein Pointer auf dem nächsten Knoten in der Liste, wenn es der letzte Element ist, dann zeigt es auf Null.
+     * @var next_ready
+     * @brief Nächste Warteschlange in der Liste der Warteschlangen, die auf einen Hilfsthread warten.
+     */
+    struct progress_queue * next_ready;
+
+    /**
+     * @var scheduled
+     * @brief 1, solange die Warteschlange in der Liste der bereiten Warteschlangen steht oder ein Hilfsthread ihre
+     * älteste Request ausführt.
+     */
+    int scheduled;
+
+    /**
+     * @var busy
+     * @brief Anzahl der eingereihten Requests, die noch nicht abgeschlossen sind. Nur wenn sie 0 ist, darf eine neue
+     * Sendung an der Warteschlange vorbei direkt versendet werden.
+     */
+    int busy;
+} progress_queue;
+
+/**
+ * @struct borrowed_buffer
+ * @brief Eine verkettete Liste der privaten Puffer, in die OSMP_RecvBorrow() große Nachrichten zusammensetzt.
+ */
+typedef struct borrowed_buffer {
+    /**
+     * @var buffer
+     * @brief Der Puffer mit der zusammengesetzten Nachricht.
      */
-    struct thread_node * next;
+    void * buffer;
 
     /**
      * @var next
-     * @brief Ein Pointer auf dem letzten Knoten in der Liste, wenn es der erste Element ist, dann zeigt es auf Null.
+     * @brief Ein Pointer auf den nächsten Knoten in der Liste, wenn es der letzte Element ist, dann zeigt es auf Null.
      */
-    struct thread_node * prev;
-} thread_node;
+    struct borrowed_buffer * next;
+} borrowed_buffer;
 
 /**
- * @struct IParams
- * @brief Struct, das die ISend-/IRecv-Funktionsparameter speichert,
+ * @struct pending_message
+ * @brief Eine Nachricht, die der Empfänger bereits aus seinem Postfach entnommen, aber noch keinem Empfangsaufruf
+ * zugeordnet hat. Jeder Knoten hängt in der Liste seines Senders und in der Liste aller wartenden Nachrichten in
+ * Ankunftsreihenfolge.
  */
-typedef struct IParams {
+typedef struct pending_message {
+    /**
+     * @var message
+     * @brief Wert aus dem Postfach (Index des Nachrichtenslots, Rendezvous-Deskriptor oder Inline-Nachricht).
+     */
+    int message;
+
+    /**
+     * @var source
+     * @brief Rang des Senders.
+     */
+    int source;
+
+    /**
+     * @var tag
+     * @brief Tag der Nachricht.
+     */
+    int tag;
+
+    /**
+     * @var prev_arrival
+     * @brief Vorherige Nachricht in Ankunftsreihenfolge.
+     */
+    struct pending_message * prev_arrival;
+
     /**
-     * @var mutex
-     * Mutex für den Zugriff auf die Elemente des Structs.
+     * @var next_arrival
+     * @brief Nächste Nachricht in Ankunftsreihenfolge.
      */
-    pthread_mutex_t mutex;
+    struct pending_message * next_arrival;
 
     /**
-     * @var convar
-     * Condition-Variable, um auf das Fertigstellen des mit diesem Struct assoziierten Prozesses zu warten.
+     * @var prev_source
+     * @brief Vorherige Nachricht desselben Senders.
      */
-    pthread_cond_t convar;
+    struct pending_message * prev_source;
 
+    /**
+     * @var next_source
+     * @brief Nächste Nachricht desselben Senders.
+     */
+    struct pending_message * next_source;
+} pending_message;
+
+/**
+ * @struct inline_message
+ * @brief Eine Inline-Nachricht, die der Empfänger aus seinem Postfach in den prozesslokalen Zwischenspeicher kopiert
+ * hat, damit der Postfach-Eintrag sofort wieder frei wird.
+ */
+typedef struct inline_message {
+    /**
+     * @var node
+     * @brief Knoten der Nachricht in den Listen der wartenden Nachrichten.
+     */
+    pending_message node;
+
+    /**
+     * @var source
+     * @brief Rang des Senders.
+     */
+    int source;
+
+    /**
+     * @var tag
+     * @brief Tag der Nachricht.
+     */
+    int tag;
+
+    /**
+     * @var len
+     * @brief Länge der Nachricht in Bytes.
+     */
+    int len;
+
+    /**
+     * @var next_free
+     * @brief Nächster freier Eintrag des Zwischenspeichers, solange dieser Eintrag frei ist.
+     */
+    int next_free;
+
+    /**
+     * @var payload
+     * @brief Nutzlast der Nachricht.
+     */
+    char payload[INLINE_PAYLOAD_LENGTH];
+} inline_message;
+
+/**
+ * @struct IParams
+ * @brief Struct, das die ISend-/IRecv-Funktionsparameter speichert,
+ */
+typedef struct IParams {
     /**
      * @var recv_buf
      * Übergabeparameter für Recv, der hier zwischengespeichert wird.
@@ -373,15 +1093,70 @@ typedef struct IParams {
     /**
      * @var done
      * Flag, das signalisiert, ob der mit diesem Struct assoziierte blockierende Vorgang abgeschlossen ist.
-     * Steht auf *OSMP_DONE*, wenn abgeschlossen, andernfalls auf *OSMP_WAITING*.
+     * Steht auf *OSMP_DONE*, wenn abgeschlossen, andernfalls auf *OSMP_WAITING*. Dient zugleich als prozessinternes
+     * Futex-Wort, auf dem OSMP_Wait() wartet.
      */
     int done;
+
+    /**
+     * @var waiters
+     * Anzahl der Threads, die auf *done* warten. Nur wenn sie größer als 0 ist, weckt die Fertigstellung.
+     */
+    int waiters;
+
+    /**
+     * @var operation
+     * REQUEST_IDLE, solange die Request unbenutzt ist, sonst REQUEST_SEND oder REQUEST_RECV.
+     */
+    int operation;
+
+    /**
+     * @var persistent
+     * 1, wenn die Operation mit OSMP_Send_init() bzw. OSMP_Recv_init() dauerhaft gebunden ist, sonst 0.
+     */
+    int persistent;
+
+    /**
+     * @var length_in_bytes
+     * Länge des Puffers in Bytes, einmalig beim Starten bzw. Binden berechnet.
+     */
+    int length_in_bytes;
+
+    /**
+     * @var next
+     * Nächste Request in derselben Warteschlange der Progress-Engine bzw., solange die Request frei ist, nächste freie
+     * Request im Request-Pool.
+     */
+    struct IParams * next;
+
+    /**
+     * @var completion
+     * Laufende Nummer der Fertigstellung innerhalb des Prozesses; ordnet abgeschlossene Requests in der Reihenfolge,
+     * in der sie fertig wurden.
+     */
+    uint64_t completion;
+
+    /**
+     * @var reported
+     * 1, sobald OSMP_Waitany() oder OSMP_Testsome() die Fertigstellung gemeldet hat; wird bei jedem Start
+     * zurückgesetzt.
+     */
+    int reported;
 } IParams;
 
-int calculate_shared_memory_size(int processes);
+size_t memory_layout(int processes, int slots, int messages_proc, memory_offsets* offsets);
+
+int calculate_shared_memory_size(int processes, int slots, int messages_proc, int payload_length);
+
+size_t heap_layout(heap_class* classes, int* class_count, size_t offset, int processes, int slots,
+                   int payload_length);
 
 void OSMP_Init_Runner(int fd, shared_memory* shm, int size);
 
+char* get_huge_page_path(const char* shared_memory_name);
+
+size_t get_mapping_length(size_t size, int huge_pages);
+
 process_info* get_process_info(int rank);
 
 #endif //BETRIEBSSYSTEME_OSMPLIB_H
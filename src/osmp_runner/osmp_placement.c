@@ -0,0 +1,290 @@
+/**
+ * In dieser Quelltext-Datei ist die Platzierung der OSMP-Prozesse auf CPUs implementiert.
+ */
+#define _GNU_SOURCE
+
+#include "osmp_placement.h"
+#include "../osmp_library/osmplib.h"
+#include "../osmp_library/OSMP.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct placement_order
+ * @brief Eine CPU zusammen mit ihrem Sortierschlüssel für eine Platzierung.
+ */
+typedef struct placement_order {
+    /**
+     * @var key
+     * Sortierschlüssel.
+     */
+    long key;
+
+    /**
+     * @var index
+     * Index der CPU im Topologie-Array.
+     */
+    int index;
+} placement_order;
+
+/**
+ * Liest die erste Zahl aus einer Datei. Bei Listen wie "0-3,8-11" ist das die kleinste CPU der Liste.
+ * @param path           Pfad zur Datei.
+ * @param default_value  Wert, der geliefert wird, wenn die Datei fehlt oder keine Zahl enthält.
+ * @return Die gelesene Zahl oder default_value.
+ */
+int read_number(const char* path, int default_value) {
+    FILE* file = fopen(path, "r");
+    if(file == NULL) {
+        return default_value;
+    }
+    int value;
+    if(fscanf(file, "%d", &value) != 1) {
+        value = default_value;
+    }
+    fclose(file);
+    return value;
+}
+
+int read_topology(const char* root, const cpu_set_t* allowed, cpu_topology* cpus) {
+    char path[MAX_PATH_LENGTH];
+    int count = 0;
+    for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if(!CPU_ISSET((size_t)cpu, allowed)) {
+            continue;
+        }
+        cpu_topology* topology = &cpus[count++];
+        topology->cpu = cpu;
+        snprintf(path, sizeof(path), "%s/cpu%d/topology/physical_package_id", root, cpu);
+        topology->package = read_number(path, 0);
+        snprintf(path, sizeof(path), "%s/cpu%d/topology/core_id", root, cpu);
+        topology->core = read_number(path, cpu);
+
+        // Die L3-Domäne wird durch die kleinste CPU benannt, die sich den Cache teilt
+        topology->l3 = topology->package;
+        for(int index = 0; ; index++) {
+            snprintf(path, sizeof(path), "%s/cpu%d/cache/index%d/level", root, cpu, index);
+            int level = read_number(path, -1);
+            if(level == -1) {
+                break;
+            }
+            if(level == 3) {
+                snprintf(path, sizeof(path), "%s/cpu%d/cache/index%d/shared_cpu_list", root, cpu, index);
+                topology->l3 = read_number(path, topology->l3);
+                break;
+            }
+        }
+    }
+
+    // Die CPUs liegen aufsteigend vor; die erste CPU eines Kerns bzw. einer L3-Domäne bestimmt deren Position
+    for(int i = 0; i < count; i++) {
+        cpu_topology* topology = &cpus[i];
+        topology->sibling = 0;
+        topology->core_in_l3 = 0;
+        topology->group = 0;
+        int first_thread = i;
+        int first_core = -1;
+        int domains = 0;
+        for(int j = 0; j < i; j++) {
+            if(cpus[j].package == topology->package && cpus[j].core == topology->core) {
+                if(topology->sibling++ == 0) {
+                    first_thread = j;
+                }
+            } else if(cpus[j].sibling == 0 && cpus[j].l3 == topology->l3) {
+                topology->core_in_l3++;
+                first_core = j;
+            }
+            if(cpus[j].sibling == 0 && cpus[j].core_in_l3 == 0) {
+                domains++;
+            }
+        }
+        if(first_thread != i) {
+            // Weitere Hardware-Threads übernehmen die Positionen des ersten Threads ihres Kerns
+            topology->core_in_l3 = cpus[first_thread].core_in_l3;
+            topology->group = cpus[first_thread].group;
+        } else if(first_core != -1) {
+            topology->group = cpus[first_core].group;
+        } else {
+            topology->group = domains;
+        }
+    }
+    return count;
+}
+
+/**
+ * Vergleicht zwei CPUs anhand ihres Sortierschlüssels (für qsort()).
+ * @param a Zeiger auf die erste placement_order.
+ * @param b Zeiger auf die zweite placement_order.
+ * @return Negativ, 0 oder positiv, je nachdem, ob a vor, mit oder nach b einzuordnen ist.
+ */
+int compare_order(const void* a, const void* b) {
+    long key_a = ((const placement_order*)a)->key;
+    long key_b = ((const placement_order*)b)->key;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+/**
+ * Liefert die Position einer CPU im Topologie-Array.
+ * @param topology Topologie der erlaubten CPUs.
+ * @param count    Anzahl der erlaubten CPUs.
+ * @param cpu      Nummer der CPU.
+ * @return Position der CPU oder -1, wenn sie nicht erlaubt ist.
+ */
+int find_cpu(const cpu_topology* topology, int count, long cpu) {
+    for(int i = 0; i < count; i++) {
+        if(topology[i].cpu == cpu) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Ordnet die Ränge der Reihe nach den CPUs einer expliziten Liste wie "0,2,4-7" zu.
+ * @param spec      Liste der CPUs.
+ * @param topology  Topologie der erlaubten CPUs.
+ * @param count     Anzahl der erlaubten CPUs.
+ * @param processes Anzahl der Ränge.
+ * @param placement Array mit processes Einträgen für die CPU jedes Rangs.
+ * @return OSMP_SUCCESS im Erfolgsfall, OSMP_FAILURE bei einer ungültigen oder nicht erlaubten Angabe.
+ */
+int assign_cpu_list(const char* spec, const cpu_topology* topology, int count, int processes, int* placement) {
+    int* list = malloc(CPU_SETSIZE * sizeof(int));
+    if(list == NULL) {
+        return OSMP_FAILURE;
+    }
+    int length = 0;
+    const char* position = spec;
+    while(*position != '\0') {
+        char* end;
+        long first = strtol(position, &end, 10);
+        long last = first;
+        if(end == position) {
+            break;
+        }
+        if(*end == '-') {
+            position = end + 1;
+            last = strtol(position, &end, 10);
+            if(end == position) {
+                break;
+            }
+        }
+        for(long cpu = first; cpu <= last && length < CPU_SETSIZE; cpu++) {
+            if(find_cpu(topology, count, cpu) == -1) {
+                printf("CPU %ld ist nicht verfügbar.\n", cpu);
+                free(list);
+                return OSMP_FAILURE;
+            }
+            list[length++] = (int)cpu;
+        }
+        position = end;
+        if(*position == ',') {
+            position++;
+        } else if(*position != '\0') {
+            break;
+        }
+    }
+    if(*position != '\0' || length == 0) {
+        printf("Ungültige Platzierung: %s\n", spec);
+        free(list);
+        return OSMP_FAILURE;
+    }
+
+    for(int rank = 0; rank < processes; rank++) {
+        placement[rank] = list[rank % length];
+    }
+    free(list);
+    return OSMP_SUCCESS;
+}
+
+int assign_cpus(const char* spec, const cpu_topology* topology, int count, int processes, int* placement) {
+    if(count == 0) {
+        return OSMP_FAILURE;
+    }
+    int is_compact = strcmp(spec, PLACEMENT_COMPACT) == 0;
+    int is_scatter = strcmp(spec, PLACEMENT_SCATTER) == 0;
+    int is_l3_pairs = strcmp(spec, PLACEMENT_L3_PAIRS) == 0;
+    if(!is_compact && !is_scatter && !is_l3_pairs) {
+        return assign_cpu_list(spec, topology, count, processes, placement);
+    }
+
+    placement_order* order = malloc((size_t)count * sizeof(placement_order));
+    if(order == NULL) {
+        return OSMP_FAILURE;
+    }
+    long base = CPU_SETSIZE;
+    int groups = 0;
+    for(int i = 0; i < count; i++) {
+        const cpu_topology* cpu = &topology[i];
+        order[i].index = i;
+        if(is_compact) {
+            order[i].key = ((long)cpu->group * base + cpu->core_in_l3) * base + cpu->sibling;
+        } else if(is_scatter) {
+            order[i].key = ((long)cpu->sibling * base + cpu->core_in_l3) * base + cpu->group;
+        } else {
+            // Innerhalb einer Domäne zuerst verschiedene Kerne, erst dann weitere Hardware-Threads
+            order[i].key = ((long)cpu->group * base + cpu->sibling) * base + cpu->core_in_l3;
+        }
+        if(cpu->group >= groups) {
+            groups = cpu->group + 1;
+        }
+    }
+    qsort(order, (size_t)count, sizeof(placement_order), compare_order);
+
+    if(!is_l3_pairs) {
+        for(int rank = 0; rank < processes; rank++) {
+            placement[rank] = topology[order[rank % count].index].cpu;
+        }
+        free(order);
+        return OSMP_SUCCESS;
+    }
+
+    // Die CPUs jeder Domäne liegen nun zusammenhängend in order; Paar p kommt in die Domäne p % groups
+    int* group_start = calloc((size_t)groups + 1, sizeof(int));
+    if(group_start == NULL) {
+        free(order);
+        return OSMP_FAILURE;
+    }
+    for(int i = 0; i < count; i++) {
+        group_start[topology[order[i].index].group + 1]++;
+    }
+    for(int group = 0; group < groups; group++) {
+        group_start[group + 1] += group_start[group];
+    }
+    for(int rank = 0; rank < processes; rank++) {
+        int pair = rank / 2;
+        int group = pair % groups;
+        int size = group_start[group + 1] - group_start[group];
+        int member = (2 * (pair / groups) + rank % 2) % size;
+        placement[rank] = topology[order[group_start[group] + member].index].cpu;
+    }
+    free(group_start);
+    free(order);
+    return OSMP_SUCCESS;
+}
+
+int compute_placement(const char* spec, int processes, int* placement) {
+    cpu_set_t allowed;
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) == -1) {
+        return OSMP_FAILURE;
+    }
+    cpu_topology* topology = malloc(CPU_SETSIZE * sizeof(cpu_topology));
+    if(topology == NULL) {
+        return OSMP_FAILURE;
+    }
+    int count = read_topology(CPU_TOPOLOGY_PATH, &allowed, topology);
+    int result = assign_cpus(spec, topology, count, processes, placement);
+    free(topology);
+    return result;
+}
+
+int pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((size_t)cpu, &set);
+    if(sched_setaffinity(0, sizeof(set), &set) == -1) {
+        return OSMP_FAILURE;
+    }
+    return OSMP_SUCCESS;
+}
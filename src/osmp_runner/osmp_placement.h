@@ -0,0 +1,119 @@
+#ifndef OSMP_PLACEMENT_H
+#define OSMP_PLACEMENT_H
+
+/**
+ * In dieser Header-Datei ist die Platzierung der OSMP-Prozesse auf CPUs deklariert. osmp_run liest die Topologie aus
+ * /sys/devices/system/cpu, ordnet jedem Rang eine CPU zu und bindet den Prozess vor execv() per sched_setaffinity()
+ * an sie. Berücksichtigt werden nur CPUs, auf denen osmp_run selbst laufen darf.
+ */
+#include <sched.h>
+
+/**
+ * Verzeichnis, aus dem die CPU-Topologie gelesen wird.
+ */
+#define CPU_TOPOLOGY_PATH "/sys/devices/system/cpu"
+
+/**
+ * Platzierung, die benachbarte Ränge auf benachbarte Kerne legt; Hardware-Threads eines Kerns werden zuerst belegt.
+ */
+#define PLACEMENT_COMPACT "compact"
+
+/**
+ * Platzierung, die benachbarte Ränge möglichst weit verteilt: erst über alle L3-Domänen, dann über die Kerne und
+ * zuletzt über die Hardware-Threads.
+ */
+#define PLACEMENT_SCATTER "scatter"
+
+/**
+ * Platzierung, die die Ränge 2k und 2k+1 auf verschiedene Kerne derselben L3-Domäne legt und die Paare über die
+ * L3-Domänen verteilt.
+ */
+#define PLACEMENT_L3_PAIRS "l3pairs"
+
+/**
+ * @struct cpu_topology
+ * @brief Lage einer CPU (eines Hardware-Threads) in der Topologie des Rechners.
+ */
+typedef struct cpu_topology {
+    /**
+     * @var cpu
+     * Nummer der CPU.
+     */
+    int cpu;
+
+    /**
+     * @var package
+     * Nummer des Sockels.
+     */
+    int package;
+
+    /**
+     * @var core
+     * Nummer des Kerns innerhalb des Sockels.
+     */
+    int core;
+
+    /**
+     * @var l3
+     * Kleinste CPU, die sich den L3-Cache mit dieser CPU teilt; ohne L3-Angabe die Nummer des Sockels.
+     */
+    int l3;
+
+    /**
+     * @var sibling
+     * Position der CPU unter den Hardware-Threads ihres Kerns.
+     */
+    int sibling;
+
+    /**
+     * @var core_in_l3
+     * Position des Kerns unter den Kernen seiner L3-Domäne.
+     */
+    int core_in_l3;
+
+    /**
+     * @var group
+     * Position der L3-Domäne unter allen L3-Domänen.
+     */
+    int group;
+} cpu_topology;
+
+/**
+ * Liest die Topologie der erlaubten CPUs.
+ * @param root    Verzeichnis der Topologie (CPU_TOPOLOGY_PATH).
+ * @param allowed Menge der CPUs, die berücksichtigt werden.
+ * @param cpus    Array mit CPU_SETSIZE Einträgen, in das die Topologie der erlaubten CPUs aufsteigend geschrieben wird.
+ * @return Anzahl der erlaubten CPUs.
+ */
+int read_topology(const char* root, const cpu_set_t* allowed, cpu_topology* cpus);
+
+/**
+ * Ordnet jedem Rang eine CPU zu.
+ * @param spec      PLACEMENT_COMPACT, PLACEMENT_SCATTER, PLACEMENT_L3_PAIRS oder eine Liste von CPUs wie "0,2,4-7".
+ *                  Gibt es mehr Ränge als CPUs, wird wieder von vorn begonnen.
+ * @param topology  Topologie der erlaubten CPUs (siehe read_topology()).
+ * @param count     Anzahl der erlaubten CPUs.
+ * @param processes Anzahl der Ränge.
+ * @param placement Array mit processes Einträgen, in das die CPU jedes Rangs geschrieben wird.
+ * @return OSMP_SUCCESS im Erfolgsfall, OSMP_FAILURE bei einer ungültigen oder nicht erlaubten Angabe.
+ */
+int assign_cpus(const char* spec, const cpu_topology* topology, int count, int processes, int* placement);
+
+/**
+ * Berechnet die Platzierung aller Ränge anhand der Topologie des Rechners und der CPUs, auf denen osmp_run laufen
+ * darf.
+ * @param spec      Platzierung wie bei assign_cpus().
+ * @param processes Anzahl der Ränge.
+ * @param placement Array mit processes Einträgen, in das die CPU jedes Rangs geschrieben wird.
+ * @return OSMP_SUCCESS im Erfolgsfall, sonst OSMP_FAILURE.
+ */
+int compute_placement(const char* spec, int processes, int* placement);
+
+/**
+ * Bindet den aufrufenden Prozess an eine CPU.
+ * @param cpu Nummer der CPU.
+ * @return OSMP_SUCCESS im Erfolgsfall, sonst OSMP_FAILURE.
+ */
+int pin_to_cpu(int cpu);
+
+#endif // OSMP_PLACEMENT_H
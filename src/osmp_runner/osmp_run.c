@@ -1,4 +1,7 @@
+#define _GNU_SOURCE
+
 #include "osmp_run.h"
+#include "osmp_placement.h"
 #include <unistd.h>
 #include <malloc.h>
 #include <stdlib.h>
@@ -17,6 +20,11 @@ int shm_size;
  */
 char* shared_memory_name;
 
+/**
+ * Pfad des Shared Memory im hugetlbfs, wenn er mit Huge Pages hinterlegt ist, sonst NULL.
+ */
+char* huge_page_path = NULL;
+
 /**
  * Erzeugt einen Mutex mit dem Attribut "shared" und kopiert ihn an den gewünschten Speicherbereich.
  * @param mutex_pointer Zeiger auf den Speicherbereich, in den der neu erzeugte Mutex kopiert werden soll.
@@ -38,35 +46,6 @@ int init_shared_mutex(pthread_mutex_t* mutex_pointer) {
     return OSMP_SUCCESS;
 }
 
-/**
- * Erzeugt eine Condition-Variable mit dem Attribut "shared" und kopiert sie an den gewünschten Speicherbereich.
- * @param cond_pointer Zeiger auf den Speicherbereich, in den die neu erzeugte Condition-Variable kopiert werden soll.
- * @return OSMP_SUCCESS im Erfolgsfall, sonst OSMP_FAILURE.
- */
-int init_shared_cond_var(pthread_cond_t* cond_pointer) {
-    // Initialisiere Condition-Variable
-    pthread_cond_t condition;
-    // Attribut anlegen
-    pthread_condattr_t condition_attr;
-    // Attribut initialisieren und verändern
-    int condition_result = pthread_condattr_init(&condition_attr);
-    if(condition_result < 0){
-        printf("Result of pthread_condattr_init = %d\n", condition_result);
-        return OSMP_FAILURE;
-    }
-    pthread_condattr_setpshared(&condition_attr, PTHREAD_PROCESS_SHARED);
-    condition_result = pthread_cond_init(&condition, &condition_attr);
-    if(condition_result < 0){
-        printf("Result of pthread_condr_init = %d\n", condition_result);
-        return OSMP_FAILURE;
-    }
-    // Condition-Variable in Shared Memory kopieren
-    memcpy(cond_pointer, &condition, sizeof(pthread_cond_t));
-    pthread_cond_destroy(&condition);
-    pthread_condattr_destroy(&condition_attr);
-    return OSMP_SUCCESS;
-}
-
 /**
  * Schließt den Shared Memory (Unmapping des SHM, Schließen des FDs, Unlinken des SHM, manuell allozierten Speicherplatz
  * für SHM-Namen freigeben).
@@ -75,7 +54,7 @@ int init_shared_cond_var(pthread_cond_t* cond_pointer) {
  * @return OSMP_SUCCESS im Erfolgsfall, sonst OSMP_FAILURE.
  */
 int free_all(int shm_fd, shared_memory* shm_ptr){
-    int result = munmap(shm_ptr, (size_t) shm_size);
+    int result = munmap(shm_ptr, get_mapping_length((size_t) shm_size, huge_page_path != NULL));
     if(result==-1){
         log_to_file(3, "Couldn't unmap memory.");
         return OSMP_FAILURE;
@@ -85,13 +64,18 @@ int free_all(int shm_fd, shared_memory* shm_ptr){
         log_to_file(3, "Couldn't close file descriptor memory.");
         return OSMP_FAILURE;
     }
-    result = shm_unlink(shared_memory_name);
+    if(huge_page_path != NULL) {
+        result = unlink(huge_page_path);
+    } else {
+        result = shm_unlink(shared_memory_name);
+    }
     if(result==-1){
         log_to_file(3, "Couldn't unlink file name.");
         return OSMP_FAILURE;
     }
     // Ab hier kein Logging mehr möglich
     free(shared_memory_name);
+    free(huge_page_path);
     return OSMP_SUCCESS;
 }
 
@@ -112,7 +96,8 @@ void kill_threads(int count, int shared_memory_fd, shared_memory* shm_ptr){
 
 
 
-int start_all_executables(int number_of_executables, char* executable, char ** arguments, shared_memory* shm_ptr, int shared_memory_fd){
+int start_all_executables(int number_of_executables, char* executable, char ** arguments, shared_memory* shm_ptr,
+                          int shared_memory_fd, const int* placement){
     int i;
     int volatile run = 1;
     pthread_mutex_lock(&(shm_ptr->initializing_mutex));
@@ -127,6 +112,10 @@ int start_all_executables(int number_of_executables, char* executable, char ** a
             run = 0;
             break;
         } else if (pid == 0) {//Child process.
+            // Die Bindung an die CPU bleibt über execv() hinweg bestehen
+            if(placement != NULL && pin_to_cpu(placement[i]) == OSMP_FAILURE) {
+                log_to_file(3,"sched_setaffinity failed");
+            }
             execv(executable, arguments);
             run = 0;
             log_to_file(3,"execv failed");
@@ -136,6 +125,7 @@ int start_all_executables(int number_of_executables, char* executable, char ** a
             // Offset berechnen (alle außer der 0. Prozess-Info gehen über SHM-Struct hinaus)
             process_info* info = &(shm_ptr->first_process_info) + i;
             info->pid = pid;
+            info->cpu = placement != NULL ? placement[i] : -1;
         }
     }
 
@@ -143,11 +133,9 @@ int start_all_executables(int number_of_executables, char* executable, char ** a
         log_to_file(3,"Problem while starting threads or processes.");
         kill_threads(i, shared_memory_fd, shm_ptr);
         pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
-        pthread_cond_broadcast(&(shm_ptr->initializing_condition));
         return OSMP_FAILURE;
     } else{
         pthread_mutex_unlock(&(shm_ptr->initializing_mutex));
-        pthread_cond_broadcast(&(shm_ptr->initializing_condition));
         for (int j = 0; j < number_of_executables; ++j) {
             int status;
             wait(&status);
@@ -186,7 +174,7 @@ int is_whitespace(const char* string) {
  * Gibt die korrekte Verwendung des Programms aus.
  */
 void printUsage(void) {
-    printf("Usage: ./osmp_run <ProcAnzahl> [-L <PfadZurLogDatei> [-V <LogVerbosität>]] ./<osmp_executable> [<param1> <param2> ...]\n");
+    printf("Usage: ./osmp_run <ProcAnzahl> [-L <PfadZurLogDatei> [-V <LogVerbosität>]] [-W <SpinBudget>] [-S <Slots>] [-Q <PostfachTiefe>] [-P <MaxNutzlast>] [-H] [-A <Platzierung>] ./<osmp_executable> [<param1> <param2> ...]\n");
 }
 
 /**
@@ -198,7 +186,7 @@ void print_logfile_condition(void) {
 
 /**
  * Diese Funktion analysiert und parst die Befehlszeilenargumente. Wenn die Argumente nicht dem geforderten Schema
- * ./osmp_run <ProcAnzahl> [-L <PfadZurLogDatei> [-V <LogVerbosität>]] ./<osmp_executable> [<param1> <param2> ...]
+ * ./osmp_run <ProcAnzahl> [-L <PfadZurLogDatei> [-V <LogVerbosität>]] [-W <SpinBudget>] [-S <Slots>] [-Q <PostfachTiefe>] [-P <MaxNutzlast>] [-H] [-A <Platzierung>] ./<osmp_executable> [<param1> <param2> ...]
  * entsprechen, wird printUsage() aufgerufen und das Programm mit EXIT_FAILURE beendet.
  * Achtung: exec_args_index kann == argc sein, nämlich dann, wenn keine Argumente für die OSMP-Executable übergeben werden.
  * Dies muss von der aufrufenden Funktion abgefangen werden.#define SHARED_MEMORY_NAME "/shared_memory"
@@ -208,10 +196,17 @@ void print_logfile_condition(void) {
  * @param[out] processes        Zeiger auf die Anzahl der Prozesse, die gestartet werden sollen.
  * @param[out] log_file         Zeiger auf den Namen des Logfiles. Wird auf NULL gesetzt, wenn argv keine Logdatei angibt.
  * @param[out] verbosity        Zeiger auf die Log-Verbosität. Wird auf 1 gesetzt, wenn argv keinen oder einen ungültigen Wert enthält.
+ * @param[out] spin_budget      Zeiger auf die maximale Anzahl aktiver Warterunden an blockierenden Stellen. Bleibt unverändert, wenn argv keinen Wert enthält.
+ * @param[out] slots            Zeiger auf die Anzahl der Nachrichtenslots. Bleibt unverändert, wenn argv keinen Wert enthält.
+ * @param[out] messages_proc    Zeiger auf die Tiefe der Postfächer. Bleibt unverändert, wenn argv keinen Wert enthält.
+ * @param[out] payload_length   Zeiger auf die maximale Nutzlast eines Nachrichtenslots in Bytes. Bleibt unverändert, wenn argv keinen Wert enthält.
+ * @param[out] huge_pages       Zeiger auf ein Flag, das auf 1 gesetzt wird, wenn der Shared Memory mit Huge Pages hinterlegt werden soll.
+ * @param[out] placement        Zeiger auf die Platzierung der Ränge auf CPUs (siehe assign_cpus()). Bleibt unverändert, wenn argv keinen Wert enthält.
  * @param[out] executable       Zeiger auf den Namen der Executable. Wird auf NULL gesetzt, wenn in den Argumenten nicht gesetzt oder leer.
  * @param[out] exec_args_index  Zeiger auf den Index in Bezug auf argv, an dem das erste an die OSMP-Executable zu übergebende Argument steht (den Namen der Executable nicht eingeschlossen).
  */
-void parse_args(int argc, char* argv[], int* processes, char** log_file, int* verbosity, char** executable, int* exec_args_index) {
+void parse_args(int argc, char* argv[], int* processes, char** log_file, int* verbosity, int* spin_budget, int* slots,
+                int* messages_proc, int* payload_length, int* huge_pages, char** placement, char** executable, int* exec_args_index) {
 
     // Überprüfen, ob ausreichend Argumente vorhanden sind
     if (argc < 3) {
@@ -253,6 +248,73 @@ void parse_args(int argc, char* argv[], int* processes, char** log_file, int* ve
             *verbosity = atoi(argv[i + 1]);
             printf("Verbosity: %d\n", *verbosity);
             i += 2;
+        } else if (strcmp(argv[i], "-W") == 0) {
+            if (i + 1 >= argc) {
+                printUsage();
+                exit(EXIT_FAILURE);
+            }
+            // Interpretation des optionalen Spin-Budgets; 0 legt wartende Prozesse sofort schlafen
+            *spin_budget = atoi(argv[i + 1]);
+            if(*spin_budget < 0) {
+                printUsage();
+                exit(EXIT_FAILURE);
+            }
+            printf("Spin budget: %d\n", *spin_budget);
+            i += 2;
+        } else if (strcmp(argv[i], "-S") == 0) {
+            if (i + 1 >= argc) {
+                printUsage();
+                exit(EXIT_FAILURE);
+            }
+            // Interpretation der optionalen Anzahl der Nachrichtenslots
+            *slots = atoi(argv[i + 1]);
+            if(*slots < 1 || *slots > MAX_CONFIGURABLE_COUNT) {
+                printf("Die Anzahl der Nachrichtenslots muss zwischen 1 und %d liegen.\n", MAX_CONFIGURABLE_COUNT);
+                exit(EXIT_FAILURE);
+            }
+            printf("Slots: %d\n", *slots);
+            i += 2;
+        } else if (strcmp(argv[i], "-Q") == 0) {
+            if (i + 1 >= argc) {
+                printUsage();
+                exit(EXIT_FAILURE);
+            }
+            // Interpretation der optionalen Tiefe der Postfächer
+            *messages_proc = atoi(argv[i + 1]);
+            if(*messages_proc < 1 || *messages_proc > MAX_CONFIGURABLE_COUNT) {
+                printf("Die Tiefe der Postfächer muss zwischen 1 und %d liegen.\n", MAX_CONFIGURABLE_COUNT);
+                exit(EXIT_FAILURE);
+            }
+            printf("Postbox depth: %d\n", *messages_proc);
+            i += 2;
+        } else if (strcmp(argv[i], "-P") == 0) {
+            if (i + 1 >= argc) {
+                printUsage();
+                exit(EXIT_FAILURE);
+            }
+            // Interpretation der optionalen maximalen Nutzlast; große Nachrichten werden in CHUNK_DEPTH Teilstücken
+            // durch einen Block dieser Größe übertragen
+            *payload_length = atoi(argv[i + 1]);
+            if(*payload_length < CHUNK_DEPTH || *payload_length > MAX_CONFIGURABLE_PAYLOAD) {
+                printf("Die maximale Nutzlast muss zwischen %d und %d Bytes liegen.\n", CHUNK_DEPTH, MAX_CONFIGURABLE_PAYLOAD);
+                exit(EXIT_FAILURE);
+            }
+            printf("Max payload: %d B\n", *payload_length);
+            i += 2;
+        } else if (strcmp(argv[i], "-H") == 0) {
+            // Shared Memory nach Möglichkeit mit Huge Pages hinterlegen
+            *huge_pages = 1;
+            printf("Huge pages: requested\n");
+            i += 1;
+        } else if (strcmp(argv[i], "-A") == 0) {
+            if (i + 1 >= argc) {
+                printUsage();
+                exit(EXIT_FAILURE);
+            }
+            // Interpretation der optionalen Platzierung: compact, scatter, l3pairs oder eine Liste wie 0,2,4-7
+            *placement = argv[i + 1];
+            printf("Placement: %s\n", *placement);
+            i += 2;
         } else {
             // Wenn kein optionales Argument erkannt wurde, brich die Schleife ab
             break;
@@ -273,6 +335,36 @@ void parse_args(int argc, char* argv[], int* processes, char** log_file, int* ve
     *exec_args_index = i;
 }
 
+/**
+ * Legt den Shared Memory als Datei im hugetlbfs an und mappt ihn, sodass er mit Huge Pages hinterlegt ist. Die Datei
+ * wird auf ein Vielfaches von HUGE_PAGE_SIZE vergrößert. Schlägt einer der Schritte fehl (kein hugetlbfs eingehängt,
+ * andere Größe der Huge Pages oder nicht genügend reservierte Huge Pages), wird die Datei wieder entfernt.
+ * @param[out] fd Zeiger auf den File Descriptor des Shared Memory.
+ * @return Zeiger auf den Shared Memory oder MAP_FAILED, wenn keine Huge Pages verfügbar sind.
+ */
+shared_memory* map_huge_page_segment(int* fd) {
+    huge_page_path = get_huge_page_path(shared_memory_name);
+    *fd = open(huge_page_path, O_CREAT | O_EXCL | O_RDWR, 0666);
+    if(*fd == -1) {
+        free(huge_page_path);
+        huge_page_path = NULL;
+        return MAP_FAILED;
+    }
+    off_t size = (off_t)get_mapping_length((size_t)shm_size, 1);
+    shared_memory* shm_ptr = MAP_FAILED;
+    // Die Huge Pages werden beim Mappen reserviert; sind nicht genug vorhanden, schlägt mmap() fehl
+    if(ftruncate(*fd, size) == 0) {
+        shm_ptr = mmap(NULL, (size_t) shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, *fd, 0);
+    }
+    if(shm_ptr == MAP_FAILED) {
+        close(*fd);
+        unlink(huge_page_path);
+        free(huge_page_path);
+        huge_page_path = NULL;
+    }
+    return shm_ptr;
+}
+
 void set_shm_name(void)  {
     int pid = getpid();
     // Länge von pid
@@ -293,51 +385,13 @@ void set_shm_name(void)  {
  * @return        OSMP_SUCCESS im Erfolgsfall, sonst OSMP_FAILURE.
  */
 int barrier_init(barrier_t *barrier, int count) {
-    int return_value;
-
     barrier->valid = !BARRIER_VALID;
-
-    return_value = init_shared_mutex(&(barrier->mutex));
-    if(return_value != OSMP_SUCCESS) {
-        log_to_file(3, "Couldn't initialize barrier mutex.");
-        return OSMP_FAILURE;
-    }
-
-    return_value = init_shared_cond_var(&(barrier->convar));
-    if(return_value != OSMP_SUCCESS) {
-        log_to_file(3, "Couldn't initialize barrier condition var.");
-        return OSMP_FAILURE;
-    }
-
     barrier->counter = count;
     barrier->cycle = 0;
     barrier->valid = BARRIER_VALID;
     return OSMP_SUCCESS;
 }
 
-/**
- * Zerstört die Synchronisierungselemente (Mutex und Condition-Variable) einer Barrier.
- * @param barrier Zeiger auf die Barrier, deren Mutex und Condition-Variable zerstört werden sollen.
- * @return OSMP_SUCCESS im Erfolgsfall, sonst OSMP_FAILURE.
- */
-int barrier_destroy(barrier_t* barrier) {
-    int rv;
-
-    rv = pthread_mutex_destroy(&(barrier->mutex));
-    if(rv != 0) {
-        log_to_file(3, "Error in destroying barrier mutex");
-        return OSMP_FAILURE;
-    }
-
-    rv = pthread_cond_destroy(&(barrier->convar));
-    if(rv != 0) {
-        log_to_file(3, "Error in destroying barrier condition variable");
-        return OSMP_FAILURE;
-    }
-
-    return OSMP_SUCCESS;
-}
-
 /**
  * Hilfsmethode, um formatierte Strings als Fehlermeldungen bei der Initialisierung von postbox_utiliites zu loggen.
  * @param format_str   Formatierungsstring für die Fehlermeldung (muss genau ein %d als Formatierungsanweisung enthalten).
@@ -360,35 +414,39 @@ void log_pb_util_init_error(const char* format_str, int process_rank) {
  * @param shm_ptr Pointer auf den Shared Memory.
  * @param processes Anzahl der Prozesse.
  * @param verbosity Logging-Verbosität.
+ * @param spin_budget Maximale Anzahl aktiver Warterunden an blockierenden Stellen.
+ * @param slots Anzahl der Nachrichtenslots.
+ * @param messages_proc Tiefe der Postfächer.
+ * @param payload_length Maximale Nutzlast eines Nachrichtenslots in Bytes.
  */
-void init_shm(shared_memory* shm_ptr, int processes, int verbosity) {
+void init_shm(shared_memory* shm_ptr, int processes, int verbosity, int spin_budget, int slots, int messages_proc,
+              int payload_length) {
     int return_value;
 
     shm_ptr->size = processes;
+    shm_ptr->max_slots = slots;
+    shm_ptr->max_messages_proc = messages_proc;
+    shm_ptr->max_payload_length = payload_length;
 
-    // Logging-Mutex wird im Logger gesetzt
-
-    // Notiere freie Slots in Liste
-    for(int i=0; i<OSMP_MAX_SLOTS; i++) {
-        shm_ptr->free_slots[i] = i;
-    }
+    // Lage der Bereiche hinter den Prozess-Infos, wie sie auch OSMP_Init() berechnet
+    memory_offsets offsets;
+    size_t heap_offset = memory_layout(processes, slots, messages_proc, &offsets);
+    int* next_free_slot = (int*)((char*)shm_ptr + offsets.next_free_slot);
+    message_slot* message_slots = (message_slot*)((char*)shm_ptr + offsets.slots);
+    char* postbox_entries = (char*)shm_ptr + offsets.postbox_entries;
 
-    // Setze Index für Liste auf 0
-    shm_ptr->free_slots_index = 0;
+    // Logging-Mutex wird im Logger gesetzt
 
-    // Initialisiere shared Semaphore für freie Slots
-    return_value = sem_init(&(shm_ptr->sem_shm_free_slots), 1, OSMP_MAX_SLOTS);
-    if(return_value != 0) {
-        log_to_file(3, "Error on initializing Semaphore sem_shm_free_slots.");
-        exit(EXIT_FAILURE);
+    // Verkette alle Slots zum Stapel der freien Slots, Slot 0 liegt oben
+    for(int i=0; i<slots; i++) {
+        next_free_slot[i] = (i+1 < slots) ? i+1 : NO_SLOT;
     }
+    shm_ptr->free_slots = TAGGED_HEAD(0, 0);
 
-    // Initialisiere Mutex für die Liste mit freien Slots
-    return_value = init_shared_mutex(&(shm_ptr->mutex_shm_free_slots));
-    if(return_value != OSMP_SUCCESS) {
-        log_to_file(3, "Error on initializing Mutex mutex_shm_free_slots.");
-        exit(EXIT_FAILURE);
-    }
+    // Ein Teil der Slots wird gleichmäßig für die Sender reserviert, damit ein Sender mit langsamem Empfänger nicht
+    // alle Slots belegen kann; der Rest bildet den gemeinsamen Vorrat
+    shm_ptr->reserved_slots = slots / (SLOT_RESERVE_SHARE * processes);
+    osmp_sem_init(&(shm_ptr->sem_shm_free_slots), slots - processes * shm_ptr->reserved_slots);
 
     return_value = init_shared_mutex(&(shm_ptr->initializing_mutex));
     if(return_value != OSMP_SUCCESS) {
@@ -396,17 +454,34 @@ void init_shm(shared_memory* shm_ptr, int processes, int verbosity) {
         exit(EXIT_FAILURE);
     }
 
-    return_value = init_shared_cond_var(&(shm_ptr->initializing_condition));
-    if(return_value != OSMP_SUCCESS) {
-        log_to_file(3, "Error on initializing Condition initializing_condition.");
-        exit(EXIT_FAILURE);
+    // Initialisiere Slots
+    for(int i=0; i<slots; i++) {
+        memset(&(message_slots[i]), '\0', sizeof(message_slot));
+        message_slots[i].credit_owner = SHARED_CREDIT;
+
+        osmp_sem_init(&(message_slots[i].sem_chunks_full), 0);
+
+        osmp_sem_init(&(message_slots[i].sem_chunks_empty), CHUNK_DEPTH);
     }
 
-    // Initialisiere Slots
-    for(int i=0; i<OSMP_MAX_SLOTS; i++) {
-        memset(&(shm_ptr->slots[i]), '\0', sizeof(message_slot));
+    // Lege die Größenklassen des Heaps hinter die Postfach-Einträge
+    heap_layout(shm_ptr->heap, &shm_ptr->heap_classes, heap_offset, processes, slots, payload_length);
+    for(int i=0; i<shm_ptr->heap_classes; i++) {
+        heap_class* heap = &(shm_ptr->heap[i]);
+        int* next = (int*)((char*)shm_ptr + heap->next_offset);
+        int* owner = (int*)((char*)shm_ptr + heap->owner_offset);
+        for(int j=0; j<heap->block_count; j++) {
+            next[j] = (j+1 < heap->block_count) ? j+1 : NO_SLOT;
+            owner[j] = NO_SLOT;
+        }
+        heap->free_blocks = TAGGED_HEAD(0, 0);
+
+        // Die nicht reservierten Blöcke bilden den gemeinsamen Vorrat der Klasse
+        osmp_sem_init(&(heap->sem_free_blocks), heap->block_count - processes * heap->reserved_blocks);
     }
 
+    osmp_sem_init(&(shm_ptr->sem_gather), 0);
+
     // Initialisiere Gather-Mutex
     return_value = init_shared_mutex(&(shm_ptr->gather_mutex));
     if(return_value != OSMP_SUCCESS) {
@@ -425,6 +500,8 @@ void init_shm(shared_memory* shm_ptr, int processes, int verbosity) {
     strncpy(shm_ptr->logfile, get_logfile_name(), MAX_PATH_LENGTH);
     shm_ptr->verbosity = (unsigned int)verbosity;
 
+    shm_ptr->spin_budget = spin_budget;
+
     // Setze Process Infos
     process_info* info = &(shm_ptr->first_process_info);
     for(int i=0; i<processes; i++) {
@@ -432,99 +509,55 @@ void init_shm(shared_memory* shm_ptr, int processes, int verbosity) {
 
         //Der Prozess ist noch nicht erreichbar.
         info->available = NOT_AVAILABLE;
-        // PID wird in start_all_executables() gesetzt
+
+        // Reservierte Nachrichtenslots des Prozesses als Sender
+        osmp_sem_init(&(info->sem_credits), shm_ptr->reserved_slots);
+        // Reservierte Heap-Blöcke des Prozesses als Sender
+        for(int j=0; j<HEAP_CLASSES; j++) {
+            int reserved_blocks = j < shm_ptr->heap_classes ? shm_ptr->heap[j].reserved_blocks : 0;
+            osmp_sem_init(&(info->sem_heap_credits[j]), reserved_blocks);
+        }
+        // PID und CPU werden in start_all_executables() gesetzt
+        info->cpu = -1;
 
         // Initialisiere postbox_utilities
         postbox_utilities* pb_util = &(info->postbox);
 
-        for(int j=0; j<OSMP_MAX_MESSAGES_PROC; j++) {
-            pb_util->postbox[j] = NO_MESSAGE;
+        // Eintrag j ist zu Beginn für die Schreibposition j frei
+        postbox_entry* entries = (postbox_entry*)(postbox_entries + (size_t)i * offsets.postbox_stride);
+        for(int j=0; j<messages_proc; j++) {
+            entries[j].slot = NO_MESSAGE;
+            entries[j].sequence = (uint64_t)j;
         }
 
         pb_util->in_index = 0;
-
-        return_value = init_shared_mutex(&(pb_util->mutex_proc_in));
-        if(return_value != OSMP_SUCCESS) {
-            log_pb_util_init_error("Couldn't initialize mutex_proc_in in postbox_utilities of process # %d", i);
-        }
-
         pb_util->out_index = 0;
 
-        return_value = init_shared_mutex(&(pb_util->mutex_proc_out));
-        if(return_value != OSMP_SUCCESS) {
-            log_pb_util_init_error("Couldn't initialize mutex_proc_out in postbox_utilities of process # %d", i);
-        }
-
-        return_value = sem_init(&(pb_util->sem_proc_empty), 1, OSMP_MAX_MESSAGES_PROC);
-        if(return_value != 0) {
-            log_pb_util_init_error("Couldn't initialize sem_proc_empty in postbox_utilities of process # %d", i);
-        }
-
-        return_value = sem_init(&(pb_util->sem_proc_full), 1, OSMP_MAX_MESSAGES_PROC);
-        pb_util->sem_proc_full_value=OSMP_MAX_MESSAGES_PROC;
-
-        init_shared_mutex(&(pb_util->sem_proc_full_value_mutex));
-
-        if(return_value != 0) {
-            log_pb_util_init_error("Couldn't initialize sem_proc_full in postbox_utilities of process # %d", i);
-        }
+        osmp_sem_init(&(pb_util->sem_proc_empty), messages_proc);
 
         // Semaphore muss anfangs blockieren, bis zu lesende Nachrichten vorliegen
-        for(int j=0; j<OSMP_MAX_MESSAGES_PROC; j++) {
-            sem_wait(&(pb_util->sem_proc_full));
-            pb_util->sem_proc_full_value--;
-        }
+        osmp_sem_init(&(pb_util->sem_proc_full), 0);
+
+        // Das Eventfd legt jeder Prozess erst in OSMP_GetEventFd() selbst an
+        info->event_armed = 0;
+        info->event_pending = EVENT_IDLE;
 
         // Initialisiere Gather-Slot
         memset(&(info->gather_slot), '\0', sizeof(message_slot));
+        info->gather_ready = 0;
+
+        // Initialisiere Rendezvous-Deskriptoren
+        for(int j=0; j<RENDEZVOUS_DESCRIPTORS; j++) {
+            memset(&(info->rendezvous[j]), '\0', sizeof(rendezvous_descriptor));
+            osmp_sem_init(&(info->rendezvous[j].sem_done), 0);
+        }
+        memset(&(info->posted), '\0', sizeof(posted_receive));
 
         // Setze Zeiger auf nächste Process-Info
         info++;
     }
 }
 
-/**
- * Zerstört die Mutexe und Semaphoren eines postbox_utilities-Structs.
- * @param postbox Zeiger auf die postbox_utilities, deren Mutexe und Semaphoren zerstört werden sollen.
- * @return OSMP_SUCCESS im Erfolgsfall, sonst OSMP_FAILURE.
- */
-int destroy_postbox_utilities(postbox_utilities* postbox) {
-    int rv;
-
-    rv = pthread_mutex_destroy(&(postbox->mutex_proc_in));
-    if(rv != 0) {
-        log_to_file(3, "Couldn't destroy mutex_proc_in");
-        return OSMP_FAILURE;
-    }
-
-    rv = pthread_mutex_destroy(&(postbox->mutex_proc_out));
-    if(rv != 0) {
-        log_to_file(3, "Couldn't destroy mutex mutex_proc_out");
-        return OSMP_FAILURE;
-    }
-
-    rv = sem_destroy(&(postbox->sem_proc_empty));
-    if(rv != 0) {
-        log_to_file(3, "Couldn't destroy semaphore sem_proc_empty");
-        return OSMP_FAILURE;
-    }
-
-    rv = sem_destroy(&(postbox->sem_proc_full));
-    postbox->sem_proc_full_value = 0;
-    if(rv != 0) {
-        log_to_file(3, "Couldn't destroy semaphore sem_proc_full");
-        return OSMP_FAILURE;
-    }
-
-    rv = pthread_mutex_destroy(&(postbox->sem_proc_full_value_mutex));
-    if(rv != 0) {
-        log_to_file(3, "Couldn't destroy mutex sem_proc_full_value_mutex");
-        return OSMP_FAILURE;
-    }
-
-    return OSMP_SUCCESS;
-}
-
 /**
  * Zerstört alle Mutexe, Semaphoren und Condition-Variablen in einem Shared Memory.
  * @param shm_ptr Zeiger auf den Shared Memory.
@@ -533,38 +566,13 @@ int destroy_postbox_utilities(postbox_utilities* postbox) {
 int cleanup_shm(shared_memory* shm_ptr) {
     int rv;
 
-    rv = sem_destroy(&(shm_ptr->sem_shm_free_slots));
-    if(rv != 0) {
-        log_to_file(3, "Couldn't destroy semaphore sem_shm_free_slots");
-        return OSMP_FAILURE;
-    }
-
-    rv = pthread_mutex_destroy(&(shm_ptr->mutex_shm_free_slots));
-    if(rv != 0) {
-        log_to_file(3, "Couldn't destroy mutex mutex_shm_free_slots");
-        return OSMP_FAILURE;
-    }
-
+    // Die Semaphoren und die Barriere basieren auf Futexen und müssen nicht zerstört werden
     rv = pthread_mutex_destroy(&(shm_ptr->gather_mutex));
     if(rv != 0) {
         log_to_file(3, "Couldn't destroy mutex gather_mutex");
         return OSMP_FAILURE;
     }
 
-    rv = barrier_destroy(&(shm_ptr->barrier));
-    if(rv != OSMP_SUCCESS) {
-        return rv;
-    }
-
-    process_info* process;
-    for(int i=0; i<shm_ptr->size; i++) {
-        process = get_process_info(i);
-        rv = destroy_postbox_utilities(&(process->postbox));
-        if(rv != OSMP_SUCCESS) {
-            return rv;
-        }
-    }
-
     // Zerstöre den Logging-Mutex zuletzt
     rv = pthread_mutex_destroy(&(shm_ptr->logging_mutex));
     if(rv != 0) {
@@ -578,50 +586,75 @@ int cleanup_shm(shared_memory* shm_ptr) {
         return OSMP_FAILURE;
     }
 
-    rv = pthread_cond_destroy(&(shm_ptr->initializing_condition));
-    if(rv != 0) {
-        puts("Couldn't destroy condition initializing_condition");
-        return OSMP_FAILURE;
-    }
-
     return OSMP_SUCCESS;
 }
 
 int main (int argc, char **argv) {
-    int processes, verbosity = 1, exec_args_index;
+    int processes, verbosity = 1, spin_budget = OSMP_DEFAULT_SPIN_BUDGET, exec_args_index;
+    int slots = OSMP_MAX_SLOTS, messages_proc = OSMP_MAX_MESSAGES_PROC, payload_length = OSMP_MAX_PAYLOAD_LENGTH;
+    int huge_pages = 0;
     char* log_file = NULL;
+    char* placement_spec = NULL;
+    int* placement = NULL;
     char* executable;
 
     set_shm_name();
 
-    parse_args(argc, argv, &processes, &log_file, &verbosity, &executable, &exec_args_index);
+    parse_args(argc, argv, &processes, &log_file, &verbosity, &spin_budget, &slots, &messages_proc, &payload_length,
+               &huge_pages, &placement_spec, &executable, &exec_args_index);
 
-    // Größe des SHM berechnen
-    shm_size = calculate_shared_memory_size(processes);
+    // CPU jedes Rangs bestimmen, bevor irgendetwas angelegt wird
+    if(placement_spec != NULL) {
+        placement = malloc((size_t)processes * sizeof(int));
+        if(placement == NULL || compute_placement(placement_spec, processes, placement) == OSMP_FAILURE) {
+            printf("Die Platzierung %s kann nicht angewendet werden.\n", placement_spec);
+            free(placement);
+            return -1;
+        }
+    }
 
-    int shared_memory_fd = shm_open(shared_memory_name, O_CREAT | O_RDWR, 0666);
-    if (shared_memory_fd==-1){
+    // Größe des SHM berechnen
+    shm_size = calculate_shared_memory_size(processes, slots, messages_proc, payload_length);
+    if(shm_size < 0) {
+        printf("Der Shared Memory wäre für diese Konfiguration zu groß.\n");
         return -1;
     }
 
-    int ftruncate_result = ftruncate(shared_memory_fd, shm_size);
-    printf("shm_size: %d B\n", shm_size);
-    if(ftruncate_result == -1){
-        return -1;
+    int shared_memory_fd = -1;
+    shared_memory *shm_ptr = MAP_FAILED;
+    if(huge_pages) {
+        shm_ptr = map_huge_page_segment(&shared_memory_fd);
+        if(shm_ptr == MAP_FAILED) {
+            printf("Keine Huge Pages verfügbar, der Shared Memory wird mit normalen Seiten angelegt.\n");
+        }
     }
-    shared_memory *shm_ptr = mmap(NULL, (size_t) shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, shared_memory_fd, 0);
-    if (shm_ptr == MAP_FAILED){
-        return -1;
+
+    if(shm_ptr == MAP_FAILED) {
+        shared_memory_fd = shm_open(shared_memory_name, O_CREAT | O_RDWR, 0666);
+        if (shared_memory_fd==-1){
+            return -1;
+        }
+
+        int ftruncate_result = ftruncate(shared_memory_fd, shm_size);
+        if(ftruncate_result == -1){
+            return -1;
+        }
+        shm_ptr = mmap(NULL, (size_t) shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, shared_memory_fd, 0);
+        if (shm_ptr == MAP_FAILED){
+            return -1;
+        }
     }
+    printf("shm_size: %d B\n", shm_size);
     logging_init_parent(shm_ptr, log_file, verbosity);
 
-    init_shm(shm_ptr, processes, verbosity);
+    init_shm(shm_ptr, processes, verbosity, spin_budget, slots, messages_proc, payload_length);
 
     OSMP_Init_Runner(shared_memory_fd, shm_ptr, shm_size);
 
     // Erstes Argument muss gemäß Konvention (execv-Manpage) Name der auszuführenden Datei sein.
     char ** arguments = argv + exec_args_index -1;
-    int starting_result = start_all_executables(processes, executable, arguments, shm_ptr, shared_memory_fd);
+    int starting_result = start_all_executables(processes, executable, arguments, shm_ptr, shared_memory_fd, placement);
+    free(placement);
 
     if(starting_result == OSMP_FAILURE){
         return -1;